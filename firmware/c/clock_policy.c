@@ -0,0 +1,158 @@
+/**
+ * @file clock_policy.c
+ * @brief System clock and core voltage per wake phase.
+ */
+
+#include "clock_policy.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/vreg.h"
+#include "hardware/sync.h"
+#include "DEV_Config.h"
+
+#define CLOCK_POLICY_WAIT_HZ       (48 * MHZ)         ///< pll_usb, kept running for USB and ADC anyway
+#define CLOCK_POLICY_WAIT_VOLTAGE  VREG_VOLTAGE_1_00  ///< Ample margin at 48 MHz
+#define CLOCK_POLICY_SETTLE_US     1000               ///< The regulator has no ready flag
+
+static spin_lock_t* clock_lock = NULL;
+static uint32_t run_hz;
+static clock_level_t demand[NUM_CORES];
+static clock_level_t applied = CLOCK_LEVEL_RUN;
+static uint64_t level_since_us;
+static uint64_t level_us[2];
+static bool run_voltage = true;            ///< Core voltage is VREG_VOLTAGE_DEFAULT
+
+/**
+ * @brief Switches clk_sys, and lowers the core voltage at the wait level (caller holds the lock).
+ *
+ * The run level needs the raised voltage (see update_level()). clk_sys goes
+ * through the glitchless mux so the other core keeps running.
+ */
+static void apply_level(clock_level_t level) {
+    if (level != applied) {
+        uint64_t now = time_us_64();
+        level_us[applied] += now - level_since_us;
+        level_since_us = now;
+
+        if (level == CLOCK_LEVEL_RUN) {
+            clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                            CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS, run_hz, run_hz);
+        } else {
+            clock_configure(clk_sys, CLOCKS_CLK_SYS_CTRL_SRC_VALUE_CLKSRC_CLK_SYS_AUX,
+                            CLOCKS_CLK_SYS_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB, CLOCK_POLICY_WAIT_HZ, CLOCK_POLICY_WAIT_HZ);
+        }
+        applied = level;
+    }
+
+    if (level == CLOCK_LEVEL_WAIT && run_voltage) {
+        vreg_set_voltage(CLOCK_POLICY_WAIT_VOLTAGE); // Lowered after the clock
+        run_voltage = false;
+    }
+}
+
+/**
+ * @brief The higher demand of both cores (caller holds the lock).
+ */
+static clock_level_t wanted_level(void) {
+    clock_level_t wanted = CLOCK_LEVEL_WAIT;
+    for (int core = 0; core < NUM_CORES; core++) {
+        if (demand[core] > wanted) {
+            wanted = demand[core];
+        }
+    }
+    return wanted;
+}
+
+/**
+ * @brief Re-evaluates the demands of both cores (caller holds the lock).
+ *
+ * The regulator has to settle before clk_sys goes up, and it has no ready
+ * flag. That wait runs with the lock released, so interrupts (cyw43, DMA)
+ * are not held off for CLOCK_POLICY_SETTLE_US; the demands are checked again
+ * afterwards.
+ *
+ * @param save Interrupt state returned by spin_lock_blocking().
+ * @return Interrupt state of the lock as held on return.
+ */
+static uint32_t update_level(uint32_t save) {
+    while (wanted_level() == CLOCK_LEVEL_RUN && !run_voltage) {
+        spin_unlock(clock_lock, save);
+        vreg_set_voltage(VREG_VOLTAGE_DEFAULT);
+        busy_wait_us(CLOCK_POLICY_SETTLE_US);
+        save = spin_lock_blocking(clock_lock);
+        run_voltage = true;
+    }
+    apply_level(wanted_level());
+    return save;
+}
+
+/**
+ * @brief Moves clk_peri to pll_usb and starts at the run level.
+ *
+ * Must be called before stdio and the SPI/I2C peripherals are initialized.
+ */
+void clock_policy_init(void) {
+    run_hz = clock_get_hz(clk_sys);
+    clock_configure(clk_peri, 0, CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_USB,
+                    CLOCK_POLICY_WAIT_HZ, CLOCK_POLICY_WAIT_HZ);
+
+    for (int core = 0; core < NUM_CORES; core++) {
+        demand[core] = CLOCK_LEVEL_RUN;
+    }
+    applied = CLOCK_LEVEL_RUN;
+    run_voltage = true;
+    level_since_us = time_us_64();
+    clock_lock = spin_lock_instance(spin_lock_claim_unused(true));
+}
+
+/**
+ * @brief Sets the demand of the calling core; the clock follows the higher demand.
+ */
+void clock_policy_set(clock_level_t level) {
+    if (clock_lock == NULL) {
+        return;
+    }
+
+    uint32_t save = spin_lock_blocking(clock_lock);
+    demand[get_core_num()] = level;
+#if CLOCK_SCALING_ENABLE
+    save = update_level(save);
+#endif
+    spin_unlock(clock_lock, save);
+}
+
+/**
+ * @brief Drops the demand of a core that was reset (core1 after multicore_reset_core1()).
+ */
+void clock_policy_release_core(unsigned int core) {
+    if (clock_lock == NULL || core >= NUM_CORES) {
+        return;
+    }
+
+    uint32_t save = spin_lock_blocking(clock_lock);
+    demand[core] = CLOCK_LEVEL_WAIT;
+#if CLOCK_SCALING_ENABLE
+    save = update_level(save);
+#endif
+    spin_unlock(clock_lock, save);
+}
+
+/**
+ * @brief Time spent at a level since clock_policy_init(), in ms.
+ */
+uint32_t clock_policy_time_ms(clock_level_t level) {
+    uint64_t us = level_us[level];
+    if (level == applied) {
+        us += time_us_64() - level_since_us;
+    }
+    return (uint32_t)(us / 1000);
+}
+
+/**
+ * @brief Delays of the ePaper driver (reset pulses, BUSY polling) are waits.
+ *
+ * Overrides the weak hook in DEV_Config.c.
+ */
+void DEV_Wait_Hook(void) {
+    clock_policy_wait();
+}
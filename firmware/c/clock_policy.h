@@ -0,0 +1,51 @@
+/**
+ * @file clock_policy.h
+ * @brief System clock and core voltage per wake phase.
+ *
+ * Most of a wake cycle is spent waiting: for the access point, the server,
+ * the panel's BUSY line or the other core. During these phases clk_sys runs
+ * from pll_usb at 48 MHz with a lowered core voltage; rendering, frame CRCs,
+ * flash writes and the cyw43 firmware download run at the boot frequency.
+ *
+ * Each core states its own demand; the clock follows the higher of both. A
+ * demand stays in place until the core changes it, so short waits in a loop
+ * (BUSY polling) do not bounce the regulator. Waits call clock_policy_wait(),
+ * compute sections clock_policy_run().
+ *
+ * Constraints:
+ * - clk_peri is moved to pll_usb (48 MHz) at init, so SPI and UART baud rates
+ *   do not depend on clk_sys.
+ * - The clock never exceeds the boot frequency: the cyw43 PIO SPI divider and
+ *   the I2C timing are set up for it and only get slower at the wait level.
+ * - 48 MHz is the floor for clk_sys while the USB controller (stdio) is on.
+ *
+ * Disabled with the CMake option CLOCK_SCALING=OFF; the time spent at each
+ * level is logged at power-down to compare the wake phases with and without.
+ */
+
+#pragma once
+#include <stdint.h>
+
+typedef enum {
+    CLOCK_LEVEL_WAIT = 0,  ///< 48 MHz from pll_usb, reduced core voltage
+    CLOCK_LEVEL_RUN,       ///< Boot frequency from pll_sys, default core voltage
+} clock_level_t;
+
+void clock_policy_init(void);
+void clock_policy_set(clock_level_t level);
+void clock_policy_release_core(unsigned int core);
+uint32_t clock_policy_time_ms(clock_level_t level);
+
+/**
+ * @brief Calling core waits (network, panel, FIFO).
+ */
+static inline void clock_policy_wait(void) {
+    clock_policy_set(CLOCK_LEVEL_WAIT);
+}
+
+/**
+ * @brief Calling core computes (rendering, CRC, flash).
+ */
+static inline void clock_policy_run(void) {
+    clock_policy_set(CLOCK_LEVEL_RUN);
+}
@@ -17,12 +17,23 @@
 #include "debug.h"
 #include <stdio.h>         // Standard I/O functions
 #include <stdarg.h>        // For variadic functions
+#include <string.h>
 #include "pico/stdlib.h"   // For `time_us_64()` to obtain timestamps
+#include "hardware/sync.h" // Spin lock around the buffer update
+
+#define DEBUG_LINE_SIZE 256 /**< One message incl. timestamp; longer ones are truncated. */
 
 static char debug_buffer[DEBUG_BUFFER_SIZE]; /**< Buffer for storing debug messages. */
 static size_t debug_buffer_index = 0;       /**< Current index in the debug buffer. */
 static DebugMode current_debug_mode = DEBUG_NONE; /**< Current debug mode. */
 
+/**
+ * Both cores log, and so do the lwIP callbacks in the cyw43 background IRQ, so
+ * a mutex cannot be used: messages are formatted on the caller's stack and only
+ * the copy into the buffer runs under a spin lock with interrupts disabled.
+ */
+static spin_lock_t* debug_lock = NULL;
+
 /**
  * @brief Initializes the debug system.
  *
@@ -46,63 +57,88 @@ void set_debug_mode(DebugMode mode) {
     current_debug_mode = mode;
 }
 
+static spin_lock_t* debug_get_lock(void) {
+    if (debug_lock == NULL) {
+        // The first message is logged on core0 at boot, before core1 and the cyw43 IRQ run
+        debug_lock = spin_lock_instance(spin_lock_claim_unused(true));
+    }
+    return debug_lock;
+}
+
 /**
- * @brief Logs a debug message with optional formatting.
- *
- * Outputs a timestamped message to the console, stores it in the buffer, or both,
- * depending on the current debug mode. Timestamps are displayed in milliseconds
- * since system start and are formatted in bold.
- *
- * @param format The format string, similar to `printf`.
- * @param ... Arguments corresponding to the format string.
+ * @brief Appends a formatted message to the debug buffer (IRQ-safe).
  */
-    void debug_log(const char* format, ...) {
-    va_list args;
-    va_start(args, format);
+static void debug_buffer_append(const char* text, size_t len) {
+    uint32_t save = spin_lock_blocking(debug_get_lock());
+    size_t space = DEBUG_BUFFER_SIZE - 1 - debug_buffer_index;
+    if (len > space) {
+        len = space;
+    }
+    memcpy(&debug_buffer[debug_buffer_index], text, len);
+    debug_buffer_index += len;
+    debug_buffer[debug_buffer_index] = '\0';
+    spin_unlock(debug_lock, save);
+}
 
-  // Get the current time in microseconds
+/**
+ * @brief Formats one message with timestamp (and color) and sends it to the enabled outputs.
+ *
+ * @param color ANSI color sequence, or NULL for the default color without reset.
+ */
+static void debug_vlog(const char* color, const char* format, va_list args) {
+    // Get the current time in microseconds
     uint64_t timestamp_us = time_us_64();
     uint64_t timestamp_ms = timestamp_us / 1000; // Convert to milliseconds
 
-    char timestamp[32];
+    char line[DEBUG_LINE_SIZE];
+    int len;
 
     // Determine the timestamp format
     if (timestamp_us < 10000) {
         // If total time is less than 10ms, display in microseconds
-        snprintf(timestamp, sizeof(timestamp), "\033[1m[%llu us]\033[0m ", (unsigned long long)timestamp_us);
+        len = snprintf(line, sizeof(line), "\033[1m[%llu us]\033[0m %s", (unsigned long long)timestamp_us, color ? color : "");
     } else {
         // Otherwise, display whole milliseconds
-        snprintf(timestamp, sizeof(timestamp), "\033[1m[%llu ms]\033[0m ", (unsigned long long)timestamp_ms);
+        len = snprintf(line, sizeof(line), "\033[1m[%llu ms]\033[0m %s", (unsigned long long)timestamp_ms, color ? color : "");
     }
 
-
+    if (len >= 0 && len < (int)sizeof(line)) {
+        len += vsnprintf(line + len, sizeof(line) - len, format, args);
+    }
+    if (color != NULL && len >= 0 && len < (int)sizeof(line)) {
+        len += snprintf(line + len, sizeof(line) - len, "%s", COLOR_RESET); // Reset text formatting
+    }
+    if (len < 0) {
+        return;
+    }
+    if (len >= (int)sizeof(line)) {
+        len = sizeof(line) - 1;
+    }
 
     if (current_debug_mode == DEBUG_REALTIME || current_debug_mode == DEBUG_BOTH) {
-        // Real-time output to console
-        printf("%s", timestamp);  // Print the timestamp
-        vprintf(format, args);   // Print the formatted message
+        // Real-time output to console, one call per message
+        printf("%s", line);
     }
 
     if (current_debug_mode == DEBUG_BUFFERED || current_debug_mode == DEBUG_BOTH) {
-        // Store message in the debug buffer
-        if (debug_buffer_index < DEBUG_BUFFER_SIZE) {
-            int written = snprintf(&debug_buffer[debug_buffer_index],
-                                   DEBUG_BUFFER_SIZE - debug_buffer_index,
-                                   "%s", timestamp);
-            if (written > 0) debug_buffer_index += written;
-
-            written = vsnprintf(&debug_buffer[debug_buffer_index],
-                                DEBUG_BUFFER_SIZE - debug_buffer_index,
-                                format, args);
-            if (written > 0) debug_buffer_index += written;
-
-            // Ensure the buffer doesn't overflow
-            if (debug_buffer_index >= DEBUG_BUFFER_SIZE) {
-                debug_buffer_index = DEBUG_BUFFER_SIZE - 1;
-            }
-        }
+        debug_buffer_append(line, (size_t)len);
     }
+}
 
+/**
+ * @brief Logs a debug message with optional formatting.
+ *
+ * Outputs a timestamped message to the console, stores it in the buffer, or both,
+ * depending on the current debug mode. Timestamps are displayed in milliseconds
+ * since system start and are formatted in bold.
+ *
+ * @param format The format string, similar to `printf`.
+ * @param ... Arguments corresponding to the format string.
+ */
+void debug_log(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    debug_vlog(NULL, format, args);
     va_end(args);
 }
 
@@ -121,61 +157,7 @@ void set_debug_mode(DebugMode mode) {
 void debug_log_with_color(const char* color, const char* format, ...) {
     va_list args;
     va_start(args, format);
-
-    // Get the current time in microseconds
-    uint64_t timestamp_us = time_us_64();
-    uint64_t timestamp_ms = timestamp_us / 1000; // Convert to milliseconds
-
-    char timestamp[32];
-
-    // Determine the timestamp format
-    if (timestamp_us < 10000) {
-        // If total time is less than 10ms, display in microseconds
-        snprintf(timestamp, sizeof(timestamp), "\033[1m[%llu us]\033[0m ", (unsigned long long)timestamp_us);
-    } else {
-        // Otherwise, display whole milliseconds
-        snprintf(timestamp, sizeof(timestamp), "\033[1m[%llu ms]\033[0m ", (unsigned long long)timestamp_ms);
-    }
-
-    if (current_debug_mode == DEBUG_REALTIME || current_debug_mode == DEBUG_BOTH) {
-        // Real-time output to console with color
-        printf("%s", timestamp);   // Print the timestamp
-        printf("%s", color);       // Apply color formatting
-        vprintf(format, args);    // Print the formatted message
-        printf(COLOR_RESET);       // Reset text formatting
-    }
-
-    if (current_debug_mode == DEBUG_BUFFERED || current_debug_mode == DEBUG_BOTH) {
-        // Store message in the debug buffer
-        if (debug_buffer_index < DEBUG_BUFFER_SIZE) {
-            int written = snprintf(&debug_buffer[debug_buffer_index],
-                                   DEBUG_BUFFER_SIZE - debug_buffer_index,
-                                   "%s", timestamp);
-            if (written > 0) debug_buffer_index += written;
-
-            written = snprintf(&debug_buffer[debug_buffer_index],
-                               DEBUG_BUFFER_SIZE - debug_buffer_index,
-                               "%s", color);
-            if (written > 0) debug_buffer_index += written;
-
-            written = vsnprintf(&debug_buffer[debug_buffer_index],
-                                DEBUG_BUFFER_SIZE - debug_buffer_index,
-                                format, args);
-            if (written > 0) debug_buffer_index += written;
-
-            // Add reset sequence to the buffer
-            written = snprintf(&debug_buffer[debug_buffer_index],
-                               DEBUG_BUFFER_SIZE - debug_buffer_index,
-                               "%s", COLOR_RESET);
-            if (written > 0) debug_buffer_index += written;
-
-            // Prevent buffer overflow
-            if (debug_buffer_index >= DEBUG_BUFFER_SIZE) {
-                debug_buffer_index = DEBUG_BUFFER_SIZE - 1;
-            }
-        }
-    }
-
+    debug_vlog(color, format, args);
     va_end(args);
 }
 
@@ -189,6 +171,10 @@ void debug_log_with_color(const char* color, const char* format, ...) {
 void transmit_debug_logs(void) {
     if (current_debug_mode == DEBUG_BUFFERED || current_debug_mode == DEBUG_BOTH) {
         printf("Buffered debug log:\n%s", debug_buffer);
+
+        uint32_t save = spin_lock_blocking(debug_get_lock());
         debug_buffer_index = 0; // Clear the buffer
+        debug_buffer[0] = '\0';
+        spin_unlock(debug_lock, save);
     }
 }
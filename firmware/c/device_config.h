@@ -52,6 +52,28 @@ typedef struct {
     float voltage_max;
 } VoltageInterval;
 
+#define DEVICE_CONFIG_VERSION  1    // Bump when fields are appended to device_config_data_t
+
+#define SCHEDULE_MAX_WINDOWS   6
+#define SCHEDULE_MAX_HOLIDAYS  16
+
+// Wake window of the weekly schedule (local time)
+typedef struct {
+    uint8_t days;              // Weekday bits, bit 0 = Monday ... bit 6 = Sunday (0 = unused entry)
+    uint8_t reserved;
+    uint16_t start_minute;     // Minute of the day the window opens
+    uint16_t end_minute;       // Minute of the day the window closes (> start_minute)
+    uint16_t interval_minutes; // Wake interval inside the window (0 = page interval)
+} schedule_window_t;
+
+// Closure day without wake-ups
+typedef struct {
+    uint8_t year;              // Years since 2000, 0 = every year
+    uint8_t month;             // 1-12, 0 = unused entry
+    uint8_t date;
+    uint8_t reserved;
+} schedule_holiday_t;
+
 typedef struct {
     char roomname[16];
     RoomType type;
@@ -75,6 +97,30 @@ typedef struct {
     uint8_t pushbutton2_pin;
     uint8_t pushbutton3_pin;
     int num_pushbuttons;
+    // Layout of the first release ends here. Newer fields are only appended below and
+    // DEVICE_CONFIG_VERSION is bumped, so migrate_device_config() (flash.c) can keep the
+    // stored part of an older config and fill the rest from DEVICE_CONFIG_DEFAULTS.
+    uint16_t config_version;        // DEVICE_CONFIG_VERSION of the layout in flash
+    uint16_t config_size;           // sizeof(device_config_data_t) of the layout in flash
+    int deghost_clear_interval;     // Clear panel before every Nth refresh (0 = never, 1 = every refresh)
+    int partial_refresh_max_percent; // Use partial refresh if dirty area <= this % of the panel (0 = off, 4.2" only)
+    int fast_refresh_mode;          // Fast waveform instead of full (0 = off, 1 = 1.5 s, 2 = 1 s; 4.2" only)
+    int full_refresh_every;         // Force a full waveform after N fast/partial refreshes (0 = never)
+    int full_refresh_changed_percent; // Force a full waveform if more than this % of pixels changed (0 = off)
+    bool fast_reconnect;            // Reuse cached BSSID/channel and DHCP lease (EEPROM) for a fast association
+    uint8_t static_ip[4];           // Static IPv4 address (0.0.0.0 = DHCP)
+    uint8_t static_netmask[4];
+    uint8_t static_gateway[4];
+    int wake_ceiling_minutes;       // Page 0 sleeps until the next booking change, at most this long while booked (0 = fixed intervals)
+    float power_saving_voltage;     // Below: power-saving tier, longer intervals, smaller Wi-Fi budget (0 = off)
+    float power_critical_voltage;   // Below: critical tier, single Wi-Fi attempt (0 = off); switch_off_battery_voltage ends operation
+    schedule_window_t schedule_windows[SCHEDULE_MAX_WINDOWS]; // Weekly schedule, used if query_only_at_officehours is set
+    schedule_holiday_t holidays[SCHEDULE_MAX_HOLIDAYS];       // No wake-ups on these days (with the schedule)
+    int wake_skew_max_minutes;      // Wake-ups at schedule openings/booking changes are delayed by a per-device 0..N minutes (0 = off)
+    int wake_skew_slot;             // Fixed per-device delay in minutes (-1 = derived from the MAC address)
+    uint8_t ntp_server[4];          // SNTP server checked during the server exchange (0.0.0.0 = off)
+    int ntp_threshold_seconds;      // Set the RTC if it is off by at least this much (0 = only log)
+    int epaper_spi_khz;             // Panel SPI clock in kHz, capped at the panel maximum (0 = panel maximum)
     // uint8_t background_id;  // keine Pointer im Flash!
     // SubImage qr_code_1_image;
     // SubImage qr_code_2_image;
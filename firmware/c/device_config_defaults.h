@@ -0,0 +1,57 @@
+#pragma once
+#include "device_config.h"
+
+/**
+ * @brief Factory defaults of device_config_data_t.
+ *
+ * Used for the default config image (default_config.c) and by
+ * migrate_device_config() (flash.c) for fields a config from an older
+ * firmware does not have yet.
+ */
+#define DEVICE_CONFIG_DEFAULTS {                                                                                      \
+    .roomname = "Room 204",                                                                                           \
+    .type = ROOM_TYPE_OFFICE,                                                                                         \
+    .epapertype = EPAPER_WAVESHARE_7IN5_V2, /* EPAPER_WAVESHARE_4IN2_V2, */                                           \
+    .refresh_minutes_by_pushbutton = {30, 30, 30, 30, 30, 30, 30, 30},                                                \
+    .show_query_date = true,                                                                                          \
+    .query_only_at_officehours = false,                                                                               \
+    .switch_off_battery_voltage = 2.7,                                                                                \
+    .description = "Office Space",                                                                                    \
+    .number_of_seats = 1,                                                                                             \
+    .number_of_people_meeting = 1,                                                                                    \
+    .has_projector = false,                                                                                           \
+    .has_conferencesystem = false,                                                                                    \
+    .conversion_factor = 0.00169,                                                                                     \
+    .wifi_reconnect_minutes = 5,                                                                                      \
+    .watchdog_time = 8000,                                                                                            \
+    .wifi_timeout = 5000,                                                                                             \
+    .number_wifi_attempts = 6,                                                                                        \
+    .max_wait_data_wifi = 100,                                                                                        \
+    .pushbutton1_pin = 7,                                                                                             \
+    .pushbutton2_pin = 6,                                                                                             \
+    .pushbutton3_pin = 5,                                                                                             \
+    .num_pushbuttons = 3,                                                                                             \
+    .config_version = DEVICE_CONFIG_VERSION,                                                                          \
+    .config_size = sizeof(device_config_data_t),                                                                      \
+    .deghost_clear_interval = 24,                                                                                     \
+    .partial_refresh_max_percent = 25,                                                                                \
+    .fast_refresh_mode = 1,                                                                                           \
+    .full_refresh_every = 10,                                                                                         \
+    .full_refresh_changed_percent = 50,                                                                               \
+    .fast_reconnect = true,                                                                                           \
+    .static_ip = {0, 0, 0, 0},                                                                                        \
+    .static_netmask = {255, 255, 255, 0},                                                                             \
+    .static_gateway = {0, 0, 0, 0},                                                                                   \
+    .wake_ceiling_minutes = 600,                                                                                      \
+    .power_saving_voltage = 3.6,                                                                                      \
+    .power_critical_voltage = 3.3,                                                                                    \
+    .schedule_windows = {                                                                                             \
+        {.days = 0x1F, .start_minute = 6 * 60, .end_minute = 19 * 60, .interval_minutes = 0} /* Mo-Fr 06:00-19:00 */  \
+    },                                                                                                                \
+    .holidays = {{0}},                                                                                                \
+    .wake_skew_max_minutes = 5,                                                                                       \
+    .wake_skew_slot = -1,                                                                                             \
+    .ntp_server = {0, 0, 0, 0}, /* off until a server is configured */                                                \
+    .ntp_threshold_seconds = 2,                                                                                       \
+    .epaper_spi_khz = 0,                                                                                              \
+}
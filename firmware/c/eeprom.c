@@ -0,0 +1,181 @@
+/**
+ * @file eeprom.c
+ * @brief Load and store the persistent wake-cycle state in the AT24C32 EEPROM.
+ */
+
+#include <string.h>
+#include "eeprom.h"
+#include "flash.h"
+#include "debug.h"
+
+wake_state_t wake_state;
+
+// Copy of the record as it is stored in the EEPROM, used to skip redundant writes
+static wake_state_t wake_state_stored;
+
+static void init_wake_state(wake_state_t* out) {
+    memset(out, 0, sizeof(*out));
+    out->data.magic = WAKE_STATE_MAGIC;
+    out->data.size = sizeof(wake_state_data_t);
+}
+
+/**
+ * @brief Reads the wake state from the EEPROM into `wake_state`.
+ *
+ * On I2C errors, an invalid CRC or a layout mismatch the state is reset to
+ * defaults, so callers can always use `wake_state` afterwards.
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ * @return true if a valid record was loaded, false if defaults are used.
+ */
+bool load_wake_state(ds3231_t* rtc) {
+    if (at24c32_read(rtc, EEPROM_WAKE_STATE_ADDR, (uint8_t*)&wake_state, sizeof(wake_state)) == 0 &&
+        wake_state.data.magic == WAKE_STATE_MAGIC &&
+        wake_state.data.size == sizeof(wake_state_data_t) &&
+        calc_crc32(&wake_state.data, sizeof(wake_state_data_t)) == wake_state.crc32) {
+        wake_state_stored = wake_state;
+        return true;
+    }
+
+    debug_log_with_color(COLOR_YELLOW, "EEPROM wake state invalid, using defaults\n");
+    init_wake_state(&wake_state);
+    memset(&wake_state_stored, 0, sizeof(wake_state_stored));
+    return false;
+}
+
+/**
+ * @brief Writes `wake_state` back to the EEPROM if it has changed.
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ * @return true on success or if nothing had to be written.
+ */
+bool save_wake_state(ds3231_t* rtc) {
+    wake_state.data.magic = WAKE_STATE_MAGIC;
+    wake_state.data.size = sizeof(wake_state_data_t);
+    wake_state.crc32 = calc_crc32(&wake_state.data, sizeof(wake_state_data_t));
+
+    if (memcmp(&wake_state, &wake_state_stored, sizeof(wake_state)) == 0) {
+        return true;
+    }
+
+    if (at24c32_write(rtc, EEPROM_WAKE_STATE_ADDR, (const uint8_t*)&wake_state, sizeof(wake_state)) != 0) {
+        debug_log_with_color(COLOR_RED, "EEPROM write of wake state failed\n");
+        return false;
+    }
+    wake_state_stored = wake_state;
+    return true;
+}
+
+/**
+ * @brief Marks the panel content as unknown, so the next wake refreshes the display.
+ *
+ * Used whenever something other than the regular page ends up on the panel
+ * (e.g. the WiFi setup screen).
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ */
+void invalidate_frame_fingerprint(ds3231_t* rtc) {
+    wake_state.data.frame_valid = 0;
+    save_wake_state(rtc);
+}
+
+wifi_cache_t wifi_cache;
+
+// Copy of the record as it is stored in the EEPROM, used to skip redundant writes
+static wifi_cache_t wifi_cache_stored;
+
+/**
+ * @brief Reads the Wi-Fi fast-reconnect cache from the EEPROM into `wifi_cache`.
+ *
+ * An invalid record is cleared, which makes the next association use the full path.
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ * @return true if a valid record was loaded.
+ */
+bool load_wifi_cache(ds3231_t* rtc) {
+    if (at24c32_read(rtc, EEPROM_WIFI_CACHE_ADDR, (uint8_t*)&wifi_cache, sizeof(wifi_cache)) == 0 &&
+        wifi_cache.data.magic == WIFI_CACHE_MAGIC &&
+        calc_crc32(&wifi_cache.data, sizeof(wifi_cache_data_t)) == wifi_cache.crc32) {
+        wifi_cache_stored = wifi_cache;
+        return true;
+    }
+
+    memset(&wifi_cache, 0, sizeof(wifi_cache));
+    wifi_cache.data.magic = WIFI_CACHE_MAGIC;
+    memset(&wifi_cache_stored, 0, sizeof(wifi_cache_stored));
+    return false;
+}
+
+/**
+ * @brief Writes `wifi_cache` back to the EEPROM if it has changed.
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ * @return true on success or if nothing had to be written.
+ */
+bool save_wifi_cache(ds3231_t* rtc) {
+    wifi_cache.data.magic = WIFI_CACHE_MAGIC;
+    wifi_cache.crc32 = calc_crc32(&wifi_cache.data, sizeof(wifi_cache_data_t));
+
+    if (memcmp(&wifi_cache, &wifi_cache_stored, sizeof(wifi_cache)) == 0) {
+        return true;
+    }
+
+    if (at24c32_write(rtc, EEPROM_WIFI_CACHE_ADDR, (const uint8_t*)&wifi_cache, sizeof(wifi_cache)) != 0) {
+        debug_log_with_color(COLOR_RED, "EEPROM write of Wi-Fi cache failed\n");
+        return false;
+    }
+    wifi_cache_stored = wifi_cache;
+    return true;
+}
+
+seat_cache_t seat_cache;
+
+// Copy of the record as it is stored in the EEPROM, used to skip redundant writes
+static seat_cache_t seat_cache_stored;
+
+/**
+ * @brief Reads the last good seat data from the EEPROM into `seat_cache`.
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ * @return true if a valid record was loaded, false if the cache is empty.
+ */
+bool load_seat_cache(ds3231_t* rtc) {
+    if (at24c32_read(rtc, EEPROM_SEAT_CACHE_ADDR, (uint8_t*)&seat_cache, sizeof(seat_cache)) == 0 &&
+        seat_cache.data.magic == SEAT_CACHE_MAGIC &&
+        seat_cache.data.size == sizeof(seat_cache_data_t) &&
+        calc_crc32(&seat_cache.data, sizeof(seat_cache_data_t)) == seat_cache.crc32) {
+        seat_cache_stored = seat_cache;
+        return true;
+    }
+
+    memset(&seat_cache, 0, sizeof(seat_cache));
+    memset(&seat_cache_stored, 0, sizeof(seat_cache_stored));
+    return false;
+}
+
+/**
+ * @brief Writes `seat_cache` back to the EEPROM if it has changed.
+ *
+ * @param rtc DS3231 instance (the EEPROM shares its I2C bus).
+ * @return true on success or if nothing had to be written.
+ */
+bool save_seat_cache(ds3231_t* rtc) {
+    if (!seat_cache.data.valid) {
+        return true;
+    }
+
+    seat_cache.data.magic = SEAT_CACHE_MAGIC;
+    seat_cache.data.size = sizeof(seat_cache_data_t);
+    seat_cache.crc32 = calc_crc32(&seat_cache.data, sizeof(seat_cache_data_t));
+
+    if (memcmp(&seat_cache, &seat_cache_stored, sizeof(seat_cache)) == 0) {
+        return true;
+    }
+
+    if (at24c32_write(rtc, EEPROM_SEAT_CACHE_ADDR, (const uint8_t*)&seat_cache, sizeof(seat_cache)) != 0) {
+        debug_log_with_color(COLOR_RED, "EEPROM write of seat cache failed\n");
+        return false;
+    }
+    seat_cache_stored = seat_cache;
+    return true;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file eeprom.h
+ * @brief Persistent wake-cycle state stored in the AT24C32 EEPROM of the DS3231 module.
+ *
+ * The device is completely unpowered between two wake-ups, so anything that has
+ * to survive a power cycle (and is written too often for the QSPI flash) lives in
+ * the 4 KB EEPROM next to the RTC. All records carry a CRC32 and are reset to
+ * defaults when the CRC or layout does not match.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "ds3231.h"
+
+/*
+ * AT24C32 EEPROM Map (4 KB = 0x1000)
+ * ┌──────────────┬──────────────────────┬────────────┬──────────────────────────────────────┐
+ * │   Address    │       Region         │   Size     │              Description             │
+ * ├──────────────┼──────────────────────┼────────────┼──────────────────────────────────────┤
+ * │ 0x000        │ Wake state           │ 128 B      │ wake_state_t (frame CRC, counters)   │
+ * │ 0x080        │ Wi-Fi cache          │ 64 B       │ wifi_cache_t (BSSID, channel, lease) │
+ * │ 0x0C0        │ Seat cache           │ 128 B      │ seat_cache_t (last good server data) │
+ * │ 0x140        │ Time sync            │ 256 B      │ time_sync_t (drift log, time_sync.h) │
+ * │ 0x240        │ Free                 │            │                                      │
+ * │ 0x400        │ Wake log             │ 2 KB       │ 64 x wake_record_t (wake_metrics.h)  │
+ * │ 0xC00        │ Free                 │            │                                      │
+ * │ 0x1000       │ EEPROM End           │            │ End of 32 kbit AT24C32               │
+ * └──────────────┴──────────────────────┴────────────┴──────────────────────────────────────┘
+ */
+
+#define EEPROM_WAKE_STATE_ADDR      0x000
+#define EEPROM_WAKE_STATE_SIZE      0x080
+
+#define EEPROM_WIFI_CACHE_ADDR      0x080
+#define EEPROM_WIFI_CACHE_SIZE      0x040
+
+#define EEPROM_SEAT_CACHE_ADDR      0x0C0
+#define EEPROM_SEAT_CACHE_SIZE      0x080
+
+#define WAKE_STATE_MAGIC            0x494E4B49  // "INKI"
+#define WIFI_CACHE_MAGIC            0x57494649  // "WIFI"
+#define SEAT_CACHE_MAGIC            0x53454154  // "SEAT"
+
+/**
+ * @brief Data that is carried over from one wake cycle to the next.
+ *
+ * New fields must be appended; a changed size invalidates the stored record
+ * and the defaults are used instead.
+ */
+typedef struct {
+    uint32_t magic;            ///< WAKE_STATE_MAGIC
+    uint16_t size;             ///< sizeof(wake_state_data_t), detects layout changes
+    uint8_t  epapertype;       ///< EpaperType the frame fingerprint belongs to
+    uint8_t  frame_valid;      ///< 1 if frame_crc describes the panel content
+    uint32_t frame_crc;        ///< CRC32 of the framebuffer currently shown on the panel
+    uint16_t refreshes_since_clear; ///< Panel refreshes since the last deghosting clear
+    uint8_t  base_frame_valid; ///< 1 if the frame in FRAME_FLASH_OFFSET matches the panel
+    uint8_t  reserved;
+    uint32_t base_frame_crc;   ///< CRC32 of the full frame stored at FRAME_FLASH_OFFSET
+    uint16_t refreshes_since_full; ///< Fast/partial refreshes since the last full waveform
+    uint16_t metrics_seq;      ///< Sequence number of the last wake record (wake_metrics.h)
+    uint16_t metrics_uploaded_seq; ///< Last wake record reported to the server
+    uint8_t  power_tier;       ///< power_tier_t of the last wake (power_governor.h)
+    uint8_t  failure_streak;   ///< Wi-Fi/server failures in a row (retry backoff)
+    uint8_t  error_shown;      ///< WifiResult of the error page on the panel (WIFI_SUCCESS = none)
+    uint8_t  mac[6];           ///< Station MAC of the last Wi-Fi wake, seeds the wake phase (wake_scheduler.c)
+    uint16_t spi_fallback_khz; ///< Panel SPI clock that failed the refresh check (0 = none, see main.c)
+} wake_state_data_t;
+
+typedef struct {
+    wake_state_data_t data;
+    uint32_t crc32;
+} wake_state_t;
+
+_Static_assert(sizeof(wake_state_t) <= EEPROM_WAKE_STATE_SIZE, "wake_state_t exceeds its EEPROM region");
+
+extern wake_state_t wake_state;
+
+bool load_wake_state(ds3231_t* rtc);
+bool save_wake_state(ds3231_t* rtc);
+void invalidate_frame_fingerprint(ds3231_t* rtc);
+
+/**
+ * @brief Connection path used for the last association (wifi_cache_data_t.last_path).
+ */
+typedef enum {
+    WIFI_PATH_FULL = 0,        ///< Scan, associate, DHCP
+    WIFI_PATH_FAST,            ///< Directed association (cached BSSID/channel), DHCP
+    WIFI_PATH_FAST_LEASE,      ///< Directed association, cached DHCP lease reused
+    WIFI_PATH_STATIC           ///< Configured static IP
+} wifi_path_t;
+
+/**
+ * @brief Last good access point and DHCP lease, used for the fast-reconnect path.
+ *
+ * Addresses are stored as lwIP `ip4_addr_t.addr` values (network byte order).
+ * Times are RTC minutes since 2000-01-01 (see rtc_minutes_since_2000()).
+ */
+typedef struct {
+    uint32_t magic;            ///< WIFI_CACHE_MAGIC
+    uint32_t network_crc;      ///< CRC32 of the SSID the entry belongs to
+    uint8_t  bssid[6];         ///< BSSID of the last access point
+    uint8_t  channel;          ///< Channel of the last access point (0 = unknown)
+    uint8_t  ap_valid;         ///< 1 if bssid/channel are usable
+    uint8_t  lease_valid;      ///< 1 if ip/netmask/gateway may be reused until lease_expiry
+    uint8_t  last_path;        ///< wifi_path_t of the last association
+    uint16_t time_to_associate_ms; ///< Last wake: connect start until associated
+    uint16_t time_to_ip_ms;    ///< Last wake: connect start until IP address available
+    uint16_t reserved;
+    uint32_t ip;
+    uint32_t netmask;
+    uint32_t gateway;
+    uint32_t lease_expiry;     ///< Lease reuse allowed until this time (half the DHCP lease)
+} wifi_cache_data_t;
+
+typedef struct {
+    wifi_cache_data_t data;
+    uint32_t crc32;
+} wifi_cache_t;
+
+_Static_assert(sizeof(wifi_cache_t) <= EEPROM_WIFI_CACHE_SIZE, "wifi_cache_t exceeds its EEPROM region");
+
+extern wifi_cache_t wifi_cache;
+
+bool load_wifi_cache(ds3231_t* rtc);
+bool save_wifi_cache(ds3231_t* rtc);
+
+/**
+ * @brief Seat data of the last successful server response.
+ *
+ * Rendered instead of an error page when Wi-Fi or the server fails (with an
+ * "as of HH:MM" marker), and by button pages within the page 0 refresh
+ * interval, which then skip the radio. Layout changes invalidate the record
+ * like for the wake state.
+ */
+typedef struct {
+    uint32_t magic;            ///< SEAT_CACHE_MAGIC
+    uint16_t size;             ///< sizeof(seat_cache_data_t)
+    uint8_t  valid;            ///< 1 after the first successful server response
+    uint8_t  is_available;
+    uint32_t fetched_at;       ///< RTC minutes since 2000 of the response
+    uint32_t frame_crc;        ///< Fingerprint of the page rendered from the live data
+    char     user_email[64];   ///< Occupant, empty if available
+    char     desk_name[32];
+} seat_cache_data_t;
+
+typedef struct {
+    seat_cache_data_t data;
+    uint32_t crc32;
+} seat_cache_t;
+
+_Static_assert(sizeof(seat_cache_t) <= EEPROM_SEAT_CACHE_SIZE, "seat_cache_t exceeds its EEPROM region");
+
+extern seat_cache_t seat_cache;
+
+bool load_seat_cache(ds3231_t* rtc);
+bool save_seat_cache(ds3231_t* rtc);
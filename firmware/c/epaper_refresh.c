@@ -0,0 +1,280 @@
+/**
+ * @file epaper_refresh.c
+ * @brief Frame comparison and refresh policy for the ePaper panel.
+ */
+
+#include <string.h>
+#include "epaper_refresh.h"
+#include "main.h"
+#include "flash.h"
+#include "eeprom.h"
+#include "debug.h"
+#include "power_governor.h"
+#include "epd_driver.h"
+
+/**
+ * @brief Adds a band of dirty rows to the damage list.
+ *
+ * If the list is full, the band is merged into the last rectangle, so the
+ * result always covers every changed pixel.
+ */
+static void add_dirty_rect(epaper_damage_t* damage, const epaper_rect_t* rect) {
+    if (damage->count < EPAPER_MAX_DIRTY_RECTS) {
+        damage->rects[damage->count++] = *rect;
+        return;
+    }
+
+    epaper_rect_t* last = &damage->rects[EPAPER_MAX_DIRTY_RECTS - 1];
+    if (rect->x_start < last->x_start) last->x_start = rect->x_start;
+    if (rect->x_end > last->x_end)     last->x_end = rect->x_end;
+    if (rect->y_start < last->y_start) last->y_start = rect->y_start;
+    if (rect->y_end > last->y_end)     last->y_end = rect->y_end;
+}
+
+/**
+ * @brief Compares two 1-bit frames and collects the changed regions.
+ *
+ * Rows are scanned top to bottom; consecutive dirty rows (allowing gaps of
+ * up to EPAPER_DIRTY_MERGE_ROWS clean rows) form one rectangle spanning the
+ * leftmost to rightmost changed byte of these rows.
+ *
+ * @param previous Frame currently shown on the panel.
+ * @param current  Newly rendered frame.
+ * @param width    Frame width in pixels.
+ * @param height   Frame height in pixels.
+ * @param damage   Output: dirty rectangles and changed pixel count.
+ */
+void epaper_compute_damage(const UBYTE* previous, const UBYTE* current,
+                           UWORD width, UWORD height, epaper_damage_t* damage) {
+    const UWORD row_bytes = (width % 8 == 0) ? (width / 8) : (width / 8 + 1);
+    epaper_rect_t band = {0};
+    bool band_open = false;
+
+    memset(damage, 0, sizeof(*damage));
+
+    for (UWORD y = 0; y < height; y++) {
+        const UBYTE* old_row = previous + (UDOUBLE)y * row_bytes;
+        const UBYTE* new_row = current + (UDOUBLE)y * row_bytes;
+        int first = -1;
+        int last = -1;
+
+        for (UWORD x = 0; x < row_bytes; x++) {
+            UBYTE diff = old_row[x] ^ new_row[x];
+            if (diff) {
+                if (first < 0) first = x;
+                last = x;
+                damage->changed_pixels += __builtin_popcount(diff);
+            }
+        }
+
+        if (first < 0) {
+            continue;
+        }
+
+        if (band_open && (y - band.y_end) <= EPAPER_DIRTY_MERGE_ROWS) {
+            if ((UWORD)(first * 8) < band.x_start) band.x_start = first * 8;
+            if ((UWORD)((last + 1) * 8) > band.x_end) band.x_end = (last + 1) * 8;
+            band.y_end = y + 1;
+        } else {
+            if (band_open) {
+                add_dirty_rect(damage, &band);
+            }
+            band.x_start = first * 8;
+            band.x_end = (last + 1) * 8;
+            band.y_start = y;
+            band.y_end = y + 1;
+            band_open = true;
+        }
+    }
+
+    if (band_open) {
+        add_dirty_rect(damage, &band);
+    }
+
+    for (int i = 0; i < damage->count; i++) {
+        const epaper_rect_t* r = &damage->rects[i];
+        damage->dirty_area += (UDOUBLE)(r->x_end - r->x_start) * (r->y_end - r->y_start);
+    }
+}
+
+/**
+ * @brief Decides whether the next refresh should start with a full panel clear.
+ *
+ * A single full-waveform Display already replaces the whole panel content, so
+ * the extra Clear is only needed now and then to remove ghosting. It is done
+ * every `deghost_clear_interval` refreshes (0 = never, 1 = every refresh) and
+ * whenever the panel content is unknown (first start, after setup mode).
+ */
+static bool is_deghost_clear_due(void) {
+    int interval = power_governor_refresh_count(device_config_flash.data.deghost_clear_interval);
+
+    if (!wake_state.data.frame_valid) {
+        return true;
+    }
+    if (interval <= 0) {
+        return false;
+    }
+    return (wake_state.data.refreshes_since_clear + 1) >= interval;
+}
+
+static bool interactive_refresh = false;
+
+/**
+ * @brief Returns true if the configured panel has a fast waveform (EPD_CAP_FAST).
+ */
+bool epaper_panel_supports_fast(void) {
+    return epd_driver_has(epd_driver_current(), EPD_CAP_FAST);
+}
+
+/**
+ * @brief Returns true if the panel has a waveform besides the full one, i.e. the frame diff matters.
+ */
+static bool panel_has_lighter_refresh(const epd_driver_t* drv) {
+    return epd_driver_has(drv, EPD_CAP_FAST) || epd_driver_has(drv, EPD_CAP_PARTIAL);
+}
+
+/**
+ * @brief Marks the refresh as answer to a button press (press-to-pixels fast path).
+ *
+ * Someone is waiting at the door: deghosting clears and forced full waveforms
+ * are left to the next scheduled wake, the fast waveform is used instead.
+ */
+void epaper_refresh_set_interactive(bool interactive) {
+    interactive_refresh = interactive;
+}
+
+/**
+ * @brief Diffs the new frame against the frame stored in flash (FRAME_FLASH_OFFSET).
+ *
+ * @return true if the stored frame is valid and `damage` was filled.
+ */
+static bool compute_damage_against_stored_frame(const UBYTE* image, epaper_damage_t* damage) {
+    if (!wake_state.data.frame_valid || !wake_state.data.base_frame_valid) {
+        return false;
+    }
+
+    const UBYTE* base = FLASH_PTR(FRAME_FLASH_OFFSET);
+    if (calc_crc32(base, get_epaper_image_size()) != wake_state.data.base_frame_crc) {
+        debug_log_with_color(COLOR_YELLOW, "Stored base frame invalid, no frame diff available\n");
+        return false;
+    }
+
+    const epd_driver_t* drv = epd_driver_current();
+    epaper_compute_damage(base, image, drv->width, drv->height, damage);
+    debug_log("Frame diff: %d dirty rects, %lu px dirty area, %lu px changed\n",
+              damage->count, (unsigned long)damage->dirty_area, (unsigned long)damage->changed_pixels);
+    return true;
+}
+
+/**
+ * @brief Selects waveform and deghosting for the next refresh.
+ *
+ * Order of the rules:
+ * 1. Deghosting clear due (see deghost_clear_interval) -> full refresh with clear.
+ * 2. Panel without fast or partial waveforms -> full refresh.
+ * 3. `full_refresh_every` fast/partial refreshes since the last full one -> full refresh.
+ * 4. More than `full_refresh_changed_percent` of the pixels changed -> full refresh.
+ * 5. Dirty area <= `partial_refresh_max_percent` of the panel -> partial refresh.
+ * 6. Fast waveform, and `fast_refresh_mode` enabled, low-battery tier or button wake -> fast refresh,
+ *    otherwise full refresh.
+ *
+ * In the low-battery tiers the deghosting and full-waveform counts are stretched;
+ * on button wakes (epaper_refresh_set_interactive()) rules 1, 3 and 4 are skipped.
+ *
+ * @param image Newly rendered framebuffer.
+ * @param plan  Output: the selected refresh.
+ */
+void epaper_plan_refresh(const UBYTE* image, epaper_refresh_plan_t* plan) {
+    const device_config_data_t* cfg = &device_config_flash.data;
+    const epd_driver_t* drv = epd_driver_current();
+
+    memset(plan, 0, sizeof(*plan));
+    plan->mode = EPAPER_REFRESH_FULL;
+    plan->clear_first = !interactive_refresh && is_deghost_clear_due();
+
+    if (plan->clear_first || !panel_has_lighter_refresh(drv)) {
+        return;
+    }
+
+    int full_refresh_every = power_governor_refresh_count(cfg->full_refresh_every);
+    if (!interactive_refresh && full_refresh_every > 0 && wake_state.data.refreshes_since_full >= full_refresh_every) {
+        debug_log("Full refresh forced after %d fast/partial refreshes\n", wake_state.data.refreshes_since_full);
+        return;
+    }
+
+    plan->damage_valid = compute_damage_against_stored_frame(image, &plan->damage);
+
+    if (plan->damage_valid) {
+        const UDOUBLE panel_area = (UDOUBLE)drv->width * drv->height;
+
+        if (!interactive_refresh && cfg->full_refresh_changed_percent > 0 &&
+            plan->damage.changed_pixels * 100 > panel_area * (UDOUBLE)cfg->full_refresh_changed_percent) {
+            debug_log("Full refresh forced, more than %d%% of the pixels changed\n", cfg->full_refresh_changed_percent);
+            return;
+        }
+
+        if (epd_driver_has(drv, EPD_CAP_PARTIAL) &&
+            cfg->partial_refresh_max_percent > 0 && cfg->partial_refresh_max_percent <= 100 &&
+            plan->damage.dirty_area * 100 <= panel_area * (UDOUBLE)cfg->partial_refresh_max_percent) {
+            plan->mode = EPAPER_REFRESH_PARTIAL;
+            return;
+        }
+    }
+
+    if (epd_driver_has(drv, EPD_CAP_FAST) &&
+        (cfg->fast_refresh_mode > 0 || power_governor_prefer_fast_refresh() || interactive_refresh)) {
+        plan->mode = EPAPER_REFRESH_FAST;
+    }
+}
+
+/**
+ * @brief Updates the refresh counters after a successful refresh.
+ *
+ * The counters are persisted by the caller together with the frame fingerprint
+ * (save_wake_state()). The stored base frame no longer matches the panel until
+ * epaper_store_base_frame() has been called.
+ *
+ * @param plan Refresh that was executed.
+ */
+void epaper_refresh_done(const epaper_refresh_plan_t* plan) {
+    wake_state.data.refreshes_since_clear = plan->clear_first ? 0 : wake_state.data.refreshes_since_clear + 1;
+    wake_state.data.refreshes_since_full = (plan->mode == EPAPER_REFRESH_FULL) ? 0 : wake_state.data.refreshes_since_full + 1;
+    wake_state.data.base_frame_valid = 0;
+}
+
+/**
+ * @brief Keeps the displayed frame in flash as base for the next partial refresh / pixel diff.
+ *
+ * Writes the QSPI flash, so it must run on core0 while core1 is idle
+ * (the other core must not execute from flash during erase/program).
+ *
+ * @param image Framebuffer that was sent to the panel.
+ */
+void epaper_store_base_frame(const UBYTE* image) {
+    const device_config_data_t* cfg = &device_config_flash.data;
+    const epd_driver_t* drv = epd_driver_current();
+
+    // Base for partial refreshes, or for the changed-pixel limit of rule 4 (epaper_plan_refresh())
+    const bool partial = epd_driver_has(drv, EPD_CAP_PARTIAL) && cfg->partial_refresh_max_percent > 0;
+    const bool changed_limit = panel_has_lighter_refresh(drv) && cfg->full_refresh_changed_percent > 0;
+    if (!partial && !changed_limit) {
+        return;
+    }
+
+    const UWORD size = get_epaper_image_size();
+    if (save_frame_to_flash(image, size)) {
+        wake_state.data.base_frame_crc = calc_crc32(image, size);
+        wake_state.data.base_frame_valid = 1;
+    }
+}
+
+/**
+ * @brief Returns a short name of the refresh mode for logging.
+ */
+const char* epaper_refresh_mode_name(epaper_refresh_mode_t mode) {
+    switch (mode) {
+        case EPAPER_REFRESH_FAST:    return "fast";
+        case EPAPER_REFRESH_PARTIAL: return "partial";
+        default:                     return "full";
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * @file epaper_refresh.h
+ * @brief Frame comparison and refresh policy for the ePaper panel.
+ *
+ * The previously displayed frame is compared byte-wise with the new
+ * framebuffer. Changed rows are grouped into byte-aligned dirty rectangles
+ * that can be pushed to the panel as partial refresh windows.
+ *
+ * The refresh policy picks the waveform for every refresh: fast or partial
+ * waveforms are used by default where the panel supports them, a full
+ * waveform is forced after a configurable number of fast/partial cycles or
+ * when too many pixels changed, so ghosting stays bounded. The counters are
+ * kept in the EEPROM wake state (eeprom.h).
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "DEV_Config.h"
+
+#define EPAPER_MAX_DIRTY_RECTS      8   ///< Further damage is merged into the last rectangle
+#define EPAPER_DIRTY_MERGE_ROWS     16  ///< Dirty rows separated by fewer clean rows share a rectangle
+
+/**
+ * @brief Dirty rectangle in pixels. X coordinates are multiples of 8, end coordinates are exclusive.
+ */
+typedef struct {
+    UWORD x_start;
+    UWORD y_start;
+    UWORD x_end;
+    UWORD y_end;
+} epaper_rect_t;
+
+/**
+ * @brief Result of comparing two frames.
+ */
+typedef struct {
+    epaper_rect_t rects[EPAPER_MAX_DIRTY_RECTS];
+    int count;                 ///< Number of valid entries in rects
+    UDOUBLE changed_pixels;    ///< Number of pixels that differ
+    UDOUBLE dirty_area;        ///< Sum of the rectangle areas in pixels
+} epaper_damage_t;
+
+/**
+ * @brief Waveform used for a refresh.
+ */
+typedef enum {
+    EPAPER_REFRESH_FULL = 0,   ///< Full waveform (best contrast, removes ghosting)
+    EPAPER_REFRESH_FAST,       ///< Fast full-screen waveform (4.2" V2)
+    EPAPER_REFRESH_PARTIAL     ///< Partial waveform of the dirty rectangles only (4.2" V2)
+} epaper_refresh_mode_t;
+
+/**
+ * @brief Decision of the refresh policy for one frame.
+ */
+typedef struct {
+    epaper_refresh_mode_t mode;
+    bool clear_first;          ///< Clear the panel before displaying (deghosting)
+    bool damage_valid;         ///< damage was computed against the stored frame
+    epaper_damage_t damage;
+} epaper_refresh_plan_t;
+
+void epaper_compute_damage(const UBYTE* previous, const UBYTE* current,
+                           UWORD width, UWORD height, epaper_damage_t* damage);
+
+void epaper_refresh_set_interactive(bool interactive);
+bool epaper_panel_supports_fast(void);
+void epaper_plan_refresh(const UBYTE* image, epaper_refresh_plan_t* plan);
+void epaper_refresh_done(const epaper_refresh_plan_t* plan);
+void epaper_store_base_frame(const UBYTE* image);
+const char* epaper_refresh_mode_name(epaper_refresh_mode_t mode);
@@ -0,0 +1,185 @@
+/**
+ * @file epd_driver.c
+ * @brief Panel driver descriptors and the registry of the linked panels.
+ */
+
+#include <stddef.h>
+#include "epd_driver.h"
+#include "flash.h"
+
+#if defined(EPD_PANEL_ONLY) && !defined(EPD_PANEL_7IN5_V2) && !defined(EPD_PANEL_4IN2_V2) && !defined(EPD_PANEL_2IN9_V2)
+#error "EPD_PANEL_ONLY needs one of EPD_PANEL_7IN5_V2, EPD_PANEL_4IN2_V2, EPD_PANEL_2IN9_V2"
+#endif
+
+#if !defined(EPD_PANEL_ONLY) || defined(EPD_PANEL_7IN5_V2)
+#include "EPD_7in5_V2.h"
+
+static void epd_7in5_v2_init(bool fast) {
+    (void)fast;
+    EPD_7IN5_V2_Init();
+}
+
+static bool epd_7in5_v2_clear(void) {
+    return EPD_7IN5_V2_Clear() == 0;
+}
+
+static bool epd_7in5_v2_display(const UBYTE* image) {
+    return EPD_7IN5_V2_Display(image) == 0;
+}
+
+static const epd_driver_t epd_7in5_v2 = {
+    .type = EPAPER_WAVESHARE_7IN5_V2,
+    .name = "Waveshare 7.5-inch V2",
+    .width = EPD_7IN5_V2_WIDTH,
+    .height = EPD_7IN5_V2_HEIGHT,
+    .bpp = 1,
+    .max_spi_hz = 10000000, // UC8179
+    .caps = 0,
+    .init = epd_7in5_v2_init,
+    .clear = epd_7in5_v2_clear,
+    .display = epd_7in5_v2_display,
+    .sleep = EPD_7IN5_V2_Sleep,
+    .info_font = &Font12,
+    .info_x = 500,
+    .info_y = 464,
+};
+#endif
+
+#if !defined(EPD_PANEL_ONLY) || defined(EPD_PANEL_4IN2_V2)
+#include "EPD_4in2_V2.h"
+
+static void epd_4in2_v2_init(bool fast) {
+    if (fast) {
+        EPD_4IN2_V2_Init_Fast(device_config_flash.data.fast_refresh_mode == 2 ? Seconds_1S : Seconds_1_5S);
+    } else {
+        EPD_4IN2_V2_Init();
+    }
+}
+
+static bool epd_4in2_v2_clear(void) {
+    return EPD_4IN2_V2_Clear() == 0;
+}
+
+static bool epd_4in2_v2_display(const UBYTE* image) {
+    return EPD_4IN2_V2_Display((UBYTE*)image) == 0;
+}
+
+static bool epd_4in2_v2_display_fast(const UBYTE* image) {
+    return EPD_4IN2_V2_Display_Fast((UBYTE*)image) == 0;
+}
+
+/**
+ * Controller RAM is lost at power-off: restore the old frame, then push only the dirty windows.
+ */
+static bool epd_4in2_v2_partial(const UBYTE* base, const UBYTE* image, const epaper_damage_t* damage) {
+    EPD_4IN2_V2_Load_Base((UBYTE*)base);
+    for (int i = 0; i < damage->count; i++) {
+        EPD_4IN2_V2_PartialWindow((UBYTE*)image, damage->rects[i].x_start, damage->rects[i].y_start,
+                                  damage->rects[i].x_end, damage->rects[i].y_end);
+    }
+    return EPD_4IN2_V2_PartialRefresh() == 0;
+}
+
+static const epd_driver_t epd_4in2_v2 = {
+    .type = EPAPER_WAVESHARE_4IN2_V2,
+    .name = "Waveshare 4.2-inch V2",
+    .width = EPD_4IN2_V2_WIDTH,
+    .height = EPD_4IN2_V2_HEIGHT,
+    .bpp = 1,
+    .max_spi_hz = 20000000, // SSD1683
+    .caps = EPD_CAP_FAST | EPD_CAP_PARTIAL,
+    .init = epd_4in2_v2_init,
+    .clear = epd_4in2_v2_clear,
+    .display = epd_4in2_v2_display,
+    .display_fast = epd_4in2_v2_display_fast,
+    .partial = epd_4in2_v2_partial,
+    .sleep = EPD_4IN2_V2_Sleep,
+    .info_font = &Font8,
+    .info_x = 150,
+    .info_y = 292,
+};
+#endif
+
+#if !defined(EPD_PANEL_ONLY) || defined(EPD_PANEL_2IN9_V2)
+#include "EPD_2in9_V2.h"
+
+static void epd_2in9_v2_init(bool fast) {
+    (void)fast;
+    EPD_2IN9_V2_Init();
+}
+
+static bool epd_2in9_v2_clear(void) {
+    return EPD_2IN9_V2_Clear() == 0;
+}
+
+static bool epd_2in9_v2_display(const UBYTE* image) {
+    return EPD_2IN9_V2_Display((UBYTE*)image) == 0;
+}
+
+static const epd_driver_t epd_2in9_v2 = {
+    .type = EPAPER_WAVESHARE_2IN9_V2,
+    .name = "Waveshare 2.9-inch V2",
+    .width = EPD_2IN9_V2_WIDTH,
+    .height = EPD_2IN9_V2_HEIGHT,
+    .bpp = 1,
+    .max_spi_hz = 20000000, // SSD1680
+    .caps = 0,
+    .init = epd_2in9_v2_init,
+    .clear = epd_2in9_v2_clear,
+    .display = epd_2in9_v2_display,
+    .sleep = EPD_2IN9_V2_Sleep,
+    .info_font = &Font8,
+    .info_x = 0,
+    .info_y = 288,
+};
+#endif
+
+static const epd_driver_t* const epd_drivers[] = {
+#if !defined(EPD_PANEL_ONLY) || defined(EPD_PANEL_7IN5_V2)
+    &epd_7in5_v2,
+#endif
+#if !defined(EPD_PANEL_ONLY) || defined(EPD_PANEL_4IN2_V2)
+    &epd_4in2_v2,
+#endif
+#if !defined(EPD_PANEL_ONLY) || defined(EPD_PANEL_2IN9_V2)
+    &epd_2in9_v2,
+#endif
+};
+
+/**
+ * @brief Looks up the descriptor of a panel type.
+ *
+ * @return The descriptor, or NULL for EPAPER_NONE and panels not linked into this build.
+ */
+const epd_driver_t* epd_driver_find(EpaperType type) {
+    for (size_t i = 0; i < sizeof(epd_drivers) / sizeof(epd_drivers[0]); i++) {
+        if (epd_drivers[i]->type == type) {
+            return epd_drivers[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Descriptor of the panel selected in the device configuration (NULL if none/unsupported).
+ */
+const epd_driver_t* epd_driver_current(void) {
+    return epd_driver_find(device_config_flash.data.epapertype);
+}
+
+/**
+ * @brief Framebuffer size in bytes (rows padded to whole bytes), 0 for NULL.
+ */
+UDOUBLE epd_driver_image_size(const epd_driver_t* drv) {
+    if (drv == NULL) {
+        return 0;
+    }
+    return (((UDOUBLE)drv->width * drv->bpp + 7) / 8) * drv->height;
+}
+
+/**
+ * @brief Returns true if the panel has all of the EPD_CAP_* flags in `caps`.
+ */
+bool epd_driver_has(const epd_driver_t* drv, uint32_t caps) {
+    return drv != NULL && (drv->caps & caps) == caps;
+}
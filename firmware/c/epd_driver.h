@@ -0,0 +1,51 @@
+/**
+ * @file epd_driver.h
+ * @brief Panel driver descriptors and the registry of the linked panels.
+ *
+ * Every supported panel is described by one epd_driver_t: framebuffer
+ * geometry, controller limits, refresh capabilities and the operations of
+ * its Waveshare driver. main.c and the refresh policy dispatch through
+ * epd_driver_current() instead of switching on the configured EpaperType.
+ *
+ * A new panel needs an EpaperType value and a descriptor in epd_driver.c.
+ * Building with `-DEPD_PANEL=<panel>` (e.g. 4IN2_V2) keeps only that
+ * descriptor in the registry, so the other drivers are not linked.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "DEV_Config.h"
+#include "fonts.h"
+#include "device_config.h"
+#include "epaper_refresh.h"
+
+#define EPD_CAP_FAST     (1u << 0) ///< Fast full-screen waveform (init(true), display_fast)
+#define EPD_CAP_PARTIAL  (1u << 1) ///< Partial refresh of dirty windows on a restored base frame
+
+typedef struct {
+    EpaperType type;
+    const char* name;          ///< Panel name for the log
+    UWORD width;               ///< Framebuffer width in pixels (Paint rotation 0)
+    UWORD height;              ///< Framebuffer height in pixels
+    UBYTE bpp;                 ///< Bits per pixel of the framebuffer
+    uint32_t max_spi_hz;       ///< Highest SPI write clock of the controller
+    uint32_t caps;             ///< EPD_CAP_* flags
+
+    // The refresh operations return false if BUSY did not release (refresh not done)
+    void (*init)(bool fast);   ///< Reset and load the full waveform, or the fast one with EPD_CAP_FAST
+    bool (*clear)(void);       ///< Full refresh to white (deghosting)
+    bool (*display)(const UBYTE* image);       ///< Full refresh of the frame
+    bool (*display_fast)(const UBYTE* image);  ///< Fast refresh, NULL without EPD_CAP_FAST
+    bool (*partial)(const UBYTE* base, const UBYTE* image, const epaper_damage_t* damage); ///< NULL without EPD_CAP_PARTIAL
+    void (*sleep)(void);       ///< Deep sleep, the controller needs init() afterwards
+
+    sFONT* info_font;          ///< Firmware info line (render_firmware_info())
+    UWORD info_x;
+    UWORD info_y;
+} epd_driver_t;
+
+const epd_driver_t* epd_driver_find(EpaperType type);
+const epd_driver_t* epd_driver_current(void);
+UDOUBLE epd_driver_image_size(const epd_driver_t* drv);
+bool epd_driver_has(const epd_driver_t* drv, uint32_t caps);
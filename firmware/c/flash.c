@@ -10,6 +10,7 @@
 #include "debug.h"
 #include "main.h"
 #include "flash.h"
+#include "device_config_defaults.h"
 #include "wifi.h"
 #include "GUI_Paint.h"               // Paint_DrawString_EN
 #include "ImageResources.h"          // BlackImage
@@ -42,7 +43,7 @@ static void init_crc32_table(void) {
     crc32_table_initialized = true;
 }
 
-static uint32_t calc_crc32(const void* data, size_t len) {
+uint32_t calc_crc32(const void* data, size_t len) {
     init_crc32_table();
     uint32_t crc = 0xFFFFFFFF;
     const uint8_t* buf = (const uint8_t*)data;
@@ -240,6 +241,52 @@ bool save_uploaded_logo_to_flash(const uint8_t* data, size_t len) {
     return true;
 }
 
+/**
+ * @brief Stores the frame that was just sent to the panel in flash.
+ *
+ * The panel controller loses its RAM when the device powers off, so the
+ * previous frame is needed as base image for a partial refresh on the next
+ * wake. Only the sectors covered by `len` are erased, and nothing is written
+ * if the stored frame is already identical.
+ *
+ * @param image Framebuffer (1 bit per pixel).
+ * @param len   Size of the framebuffer in bytes (max. FRAME_FLASH_SIZE).
+ * @return true on success, false if the frame does not fit.
+ */
+bool save_frame_to_flash(const uint8_t* image, size_t len) {
+    if (len == 0 || len > FRAME_FLASH_SIZE) {
+        debug_log_with_color(COLOR_RED, "Frame too large for flash storage (%u bytes)\n", (unsigned)len);
+        return false;
+    }
+
+    // Same frame as stored (e.g. a refresh with the previous content): spare the erase cycle
+    if (memcmp(FLASH_PTR(FRAME_FLASH_OFFSET), image, len) == 0) {
+        return true;
+    }
+
+    const size_t erase_len = (len + FLASH_SECTOR_SIZE - 1) & ~(FLASH_SECTOR_SIZE - 1);
+    const size_t full_pages_len = len & ~(FLASH_PAGE_SIZE - 1);
+
+    uint32_t ints = save_and_disable_interrupts();
+    flash_range_erase(FRAME_FLASH_OFFSET, erase_len);
+    if (full_pages_len) {
+        flash_range_program(FRAME_FLASH_OFFSET, image, full_pages_len);
+    }
+    restore_interrupts(ints);
+
+    // Program the remaining bytes as one padded page
+    if (len > full_pages_len) {
+        uint8_t last_page[FLASH_PAGE_SIZE];
+        memset(last_page, 0xFF, sizeof(last_page));
+        memcpy(last_page, image + full_pages_len, len - full_pages_len);
+
+        ints = save_and_disable_interrupts();
+        flash_range_program(FRAME_FLASH_OFFSET + full_pages_len, last_page, FLASH_PAGE_SIZE);
+        restore_interrupts(ints);
+    }
+
+    return true;
+}
 
 // ------------------------------
 // Wi-Fi config functions
@@ -337,6 +384,62 @@ void init_device_config(device_config_t* out_config) {
     }
 }
 
+const device_config_data_t device_config_defaults = DEVICE_CONFIG_DEFAULTS;
+
+/**
+ * @brief Brings the device config in flash to the current layout.
+ *
+ * Fields are only appended to device_config_data_t, so the part an older firmware
+ * stored is kept and the rest is filled from device_config_defaults. The stored part
+ * is trusted if its CRC matches, either at the size recorded in config_size or at the
+ * layout of the first release (which had no version fields; crc32 = 0 is the unsaved
+ * factory image). Erased or corrupt flash gets the full defaults.
+ *
+ * Called once at boot on core0 before anything reads device_config_flash.
+ *
+ * @return true if the config was rewritten.
+ */
+bool migrate_device_config(void) {
+    const uint8_t* raw = (const uint8_t*)FLASH_PTR(DEVICE_CONFIG_FLASH_OFFSET);
+    const device_config_data_t* stored = &device_config_flash.data;
+    const size_t legacy_size = offsetof(device_config_data_t, config_version);
+    size_t keep = 0;
+    uint32_t stored_crc;
+
+    if (stored->config_version == DEVICE_CONFIG_VERSION && stored->config_size == sizeof(device_config_data_t)) {
+        return false;
+    }
+
+    if (stored->config_version < DEVICE_CONFIG_VERSION &&
+        stored->config_size > legacy_size && stored->config_size < sizeof(device_config_data_t)) {
+        memcpy(&stored_crc, raw + stored->config_size, sizeof(stored_crc));
+        if (calc_crc32(raw, stored->config_size) == stored_crc) {
+            keep = stored->config_size;
+        }
+    }
+
+    if (keep == 0) {
+        memcpy(&stored_crc, raw + legacy_size, sizeof(stored_crc));
+        if (stored_crc == 0 || calc_crc32(raw, legacy_size) == stored_crc) {
+            keep = legacy_size;
+        }
+    }
+
+    device_config_t migrated = { .data = device_config_defaults, .crc32 = 0 };
+    memcpy(&migrated.data, raw, keep);
+    migrated.data.config_version = DEVICE_CONFIG_VERSION;
+    migrated.data.config_size = sizeof(device_config_data_t);
+
+    if (keep == 0) {
+        debug_log_with_color(COLOR_YELLOW, "Device config invalid, restoring defaults\n");
+    } else {
+        debug_log_with_color(COLOR_YELLOW, "Device config migrated: kept %u of %u bytes\n",
+                             (unsigned)keep, (unsigned)sizeof(device_config_data_t));
+    }
+
+    return save_device_config(&migrated);
+}
+
 const void* keep_device_config_flash = &device_config_flash;
 const void* keep_wifi_config_flash = &wifi_config_flash;
 const void* keep_seatsurfing_config_flash = &seatsurfing_config_flash;
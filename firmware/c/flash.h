@@ -23,6 +23,7 @@ _Static_assert(FIRMWARE_MAGIC_LEN == 13, "FIRMWARE_MAGIC_LEN mismatch");
  * │ 0x010000     │ Firmware Slot 0      │ 940 KB     │ FIRMWARE_FLASH_SIZE = 0xEB800        │
  * │ 0x0FB800     │ Firmware Slot 1      │ 940 KB     │ FIRMWARE_FLASH_SIZE = 0xEB800        │
  * │ 0x1E7000     │ Config & Reserved    │ 100 KB     │ Configuration, logos, OTA buffers    │
+ * │   0x1EC000   │   └ Last frame       │  48 KB     │ FRAME_FLASH_OFFSET, partial base     │
  * │ 0x200000     │ Flash End            │            │ End of 2 MB QSPI flash               │
  * └──────────────┴──────────────────────┴────────────┴──────────────────────────────────────┘
  *
@@ -54,6 +55,10 @@ _Static_assert(FIRMWARE_MAGIC_LEN == 13, "FIRMWARE_MAGIC_LEN mismatch");
 #define LOGO_FLASH_OFFSET                 (CONFIG_FLASH_OFFSET + 0x3000)  // 0x1EA000 - Uploadable logo binary
 #define LOGO_FLASH_SIZE                   0x2000                          // 8192 bytes reserved for 1-bit bitmap logo, has to be in multiples of FLASH_SECTOR_SIZE
 
+// Last displayed frame (48 KB = 12 flash sectors, fits the 800x480 1-bit framebuffer)
+#define FRAME_FLASH_OFFSET                (CONFIG_FLASH_OFFSET + 0x5000)  // 0x1EC000 - Frame currently shown on the panel (partial refresh base)
+#define FRAME_FLASH_SIZE                  0xC000                          // 49152 bytes, has to be in multiples of FLASH_SECTOR_SIZE
+
 #ifndef FLASH_PAGE_SIZE
 #define FLASH_PAGE_SIZE                   256  // 0x100 = 256, entspricht (1u << 8)
 #endif
@@ -96,6 +101,9 @@ typedef struct __attribute__((packed)) {
     uint8_t reserved[185];      // Reserve für spätere Erweiterung
 } firmware_header_t;
 
+/* CRC32 (IEEE 802.3) used for config blocks and EEPROM records */
+uint32_t calc_crc32(const void* data, size_t len);
+
 /* Wi-Fi config */
 bool load_wifi_config(wifi_config_t* out);
 bool save_wifi_config(const wifi_config_t* in);
@@ -110,8 +118,11 @@ void init_seatsurfing_config(seatsurfing_config_t* out);
 bool load_device_config(device_config_t* out);
 bool save_device_config(const device_config_t* in);
 void init_device_config(device_config_t* out);
+bool migrate_device_config(void);
+extern const device_config_data_t device_config_defaults;
 
 bool save_uploaded_logo_to_flash(const uint8_t* data, size_t len);
+bool save_frame_to_flash(const uint8_t* image, size_t len);
 const char* get_active_firmware_slot_info(void);
 bool get_firmware_slot_info(
     uint8_t slot,
@@ -1,22 +1,31 @@
 #include <stdio.h>
+#include <strings.h>
 #include "pico/stdlib.h"
 #include "pico/cyw43_arch.h"
 #include "lwip/altcp.h"
 #include "lwip/ip_addr.h"
+#include "lwip/dhcp.h"
 #include "hardware/adc.h"
 #include "hardware/watchdog.h"
+#include "pico/multicore.h"
 #include "config.h"
 #include "version.h"
 #include "wifi.h"
 #include "DEV_Config.h"
 #include "GUI_Paint.h"
 #include "ImageResources.h"
-#include "EPD_7in5_V2.h"
-#include "EPD_4in2_V2.h"
-#include "EPD_2in9_V2.h"
+#include "epd_driver.h"
 #include "ds3231.h"
 #include "debug.h"
 #include "flash.h"
+#include "eeprom.h"
+#include "epaper_refresh.h"
+#include "wake_scheduler.h"
+#include "wake_metrics.h"
+#include "power_governor.h"
+#include "clock_policy.h"
+#include "time_sync.h"
+#include "wake_context.h"
 #include "webserver.h"
 #include "base64.h"
 
@@ -30,18 +39,30 @@
  * - This buffer is processed later to extract required information for updating the ePaper display.
  * - Assumes single-threaded usage and is not thread-safe.
  */
-static char server_response_buf[2048];
+static char server_response_buf[4096];
 
 /**
- * Temporary buffer for handling one chunk of TCP data.
- * - Used in the `recv` function to copy data from the incoming packet
- *   before appending it to the global `server_response_buf` buffer.
+ * Receive state of the HTTP response in `server_response_buf`.
+ * - Updated incrementally by the lwIP callbacks (`recv`, `altcp_client_err`),
+ *   so the header is scanned only once and completion is known immediately.
+ * - `wifi_server_communication` waits until `complete`, `closed` or `error` is set.
  */
-static char recv_chunk_buf[1024];
+typedef struct {
+    size_t len;              // Bytes stored in server_response_buf
+    int header_len;          // Length of the header incl. "\r\n\r\n", -1 until it is complete
+    int content_length;      // Parsed Content-Length, -1 if unknown
+    volatile bool complete;  // Header and full body received
+    volatile bool closed;    // Remote side closed the connection
+    volatile bool error;     // Connection aborted or buffer overflow
+} http_response_t;
+
+static http_response_t http_response;
+static struct altcp_pcb* http_pcb = NULL;
 
 static char submitted_text[128] = "";
 
 ds3231_t ds3231; // RTC definition
+static wake_context_t wake_context; // RTC time, temperature and voltages, taken once at boot
 // extern const wifi_config_t wifi_config_flash;
 // extern const seatsurfing_config_t seatsurfing_config_flash;
 // extern const device_config_t device_config_flash;
@@ -69,23 +90,13 @@ bool pb3 = false;
  */
 void DrawSubImage(UBYTE* buffer, const SubImage* sub_image, int x, int y) {
     // Get buffer dimensions dynamically
-    int buffer_width, buffer_height;
-
-    switch (device_config_flash.data.epapertype) {
-        case EPAPER_WAVESHARE_7IN5_V2:
-            buffer_width = EPD_7IN5_V2_WIDTH;
-            buffer_height = EPD_7IN5_V2_HEIGHT;
-            break;
-
-        case EPAPER_WAVESHARE_4IN2_V2:
-            buffer_width = EPD_4IN2_V2_WIDTH;
-            buffer_height = EPD_4IN2_V2_HEIGHT;
-            break;
-
-        default:
-            debug_log_with_color(COLOR_RED, "Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
-            return;
+    const epd_driver_t* drv = epd_driver_current();
+    if (drv == NULL) {
+        debug_log_with_color(COLOR_RED, "Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
+        return;
     }
+    int buffer_width = drv->width;
+    int buffer_height = drv->height;
 
     // Iterate over the sub-image and write pixels to the buffer
     for (int j = 0; j < sub_image->height; j++) {
@@ -309,6 +320,56 @@ void format_rtc_time(const ds3231_data_t* t, char* buffer, size_t buffer_size) {
              2000 + t->year);
 }
 
+/**
+ * @brief Converts an RTC time (standard time, years 2000-2099) to minutes since 2000-01-01 00:00.
+ *
+ * Used for expiry times that are stored across power cycles (e.g. the Wi-Fi lease cache).
+ */
+uint32_t rtc_minutes_since_2000(const ds3231_data_t* t) {
+    static const uint16_t days_before_month[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    uint32_t year = t->year;
+    uint32_t month = (t->month >= 1 && t->month <= 12) ? t->month : 1;
+
+    uint32_t days = year * 365 + (year + 3) / 4;   // Leap days of the previous years (2000 is a leap year)
+    days += days_before_month[month - 1] + (t->date > 0 ? t->date - 1 : 0);
+    if (month > 2 && (year % 4) == 0) {
+        days += 1;
+    }
+    return (days * 24 + t->hours) * 60 + t->minutes;
+}
+
+/**
+ * @brief Converts minutes since 2000-01-01 00:00 back to date, time and weekday (inverse of rtc_minutes_since_2000()).
+ */
+void rtc_minutes_to_time(uint32_t minutes, ds3231_data_t* t) {
+    static const uint8_t days_in_month[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint32_t days = minutes / (24 * 60);
+    uint32_t minute_of_day = minutes % (24 * 60);
+
+    memset(t, 0, sizeof(*t));
+    t->minutes = minute_of_day % 60;
+    t->hours = minute_of_day / 60;
+    t->day = ((days + 5) % 7) + 1; // 2000-01-01 was a Saturday (1 = Monday)
+
+    int year = 0;
+    while (days >= ((year % 4 == 0) ? 366u : 365u)) {
+        days -= (year % 4 == 0) ? 366 : 365;
+        year++;
+    }
+
+    int month = 0;
+    while (true) {
+        uint32_t month_days = days_in_month[month] + ((month == 1 && year % 4 == 0) ? 1 : 0);
+        if (days < month_days) break;
+        days -= month_days;
+        month++;
+    }
+
+    t->year = year;
+    t->month = month + 1;
+    t->date = days + 1;
+}
+
 // Output: "13:45"
 void format_short_time(const ds3231_data_t* t, char* buffer, size_t buffer_size) {
     int hour = t->hours;
@@ -352,23 +413,58 @@ void read_mac_address() {
 }
 
 //  ---------------------functions for handling wifi--------------------------------
+/**
+ * @brief Parses the HTTP header once its end has been received.
+ *
+ * Only the newly appended bytes (plus 3 bytes of overlap for a split
+ * "\r\n\r\n") are scanned, so the total work stays linear in the response size.
+ *
+ * @param scan_from Offset of the first new byte in `server_response_buf`.
+ */
+static void http_response_parse_header(size_t scan_from) {
+    if (http_response.header_len >= 0) {
+        return;
+    }
+
+    size_t start = (scan_from > 3) ? scan_from - 3 : 0;
+    char* header_end = strstr(server_response_buf + start, "\r\n\r\n");
+    if (header_end == NULL) {
+        return;
+    }
+    http_response.header_len = (int)(header_end - server_response_buf) + 4;
+
+    // Parse Content-Length (header names are case-insensitive)
+    for (char* line = server_response_buf; line < header_end; ) {
+        char* eol = strstr(line, "\r\n");
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            char* cl = line + 15;
+            while (*cl == ' ') cl++;
+            http_response.content_length = atoi(cl);
+            debug_log("Parsed Content-Length: %d\n", http_response.content_length);
+            break;
+        }
+        if (eol == NULL) break;
+        line = eol + 2;
+    }
+}
+
 /**
  * Callback function for handling received TCP data.
  *
  * This function appends received data chunks to the global `server_response_buf` buffer, which accumulates
- * the complete response from the server. The data in `server_response_buf` is then used by other parts
- * of the program.
+ * the complete response from the server, and updates the receive state in `http_response`.
+ * As soon as the header and `Content-Length` bytes of body are in, the response is marked
+ * complete, so the caller can switch the radio off without further polling.
  *
  * Notes:
- * - Uses the global buffers `server_response_buf` and `recv_chunk_buf`. Ensure these buffers are large enough
- *   to hold the maximum expected data size.
+ * - `server_response_buf` is kept null-terminated for the parsers.
  * - Includes a size check to prevent buffer overflow. If the received data exceeds the
- *   available space in `server_response_buf`, the function will log a warning and discard the excess data.
- * - Assumes single-threaded execution. In a multi-threaded environment, additional
- *   synchronization mechanisms would be required to avoid race conditions.
+ *   available space in `server_response_buf`, the response is marked as failed.
+ * - A NULL pbuf means the server closed the connection; for responses without
+ *   `Content-Length` the body then ends there (HTTP/1.0).
  *
  * Parameters:
- * - arg: Not used directly but can be used for context in a more advanced design.
+ * - arg: HTTP request header (see `altcp_client_connected`).
  * - pcb: Pointer to the TCP protocol control block.
  * - p: Pointer to the received buffer (if NULL, indicates connection closed).
  * - err: Error status of the received data.
@@ -379,31 +475,79 @@ void read_mac_address() {
  */
 
 err_t recv(void *arg, struct altcp_pcb *pcb, struct pbuf *p, err_t err) {
-    if (p != NULL) {
-        size_t current_data_len = strlen(server_response_buf);
-        size_t remaining_space = sizeof(server_response_buf) - current_data_len - 1; // Leave space for null terminator
-
-        if (p->tot_len > remaining_space) {
-            debug_log("Buffer overflow risk: received data exceeds buffer size.\n");
-            altcp_recved(pcb, p->tot_len);
+    if (err != ERR_OK) {
+        if (p != NULL) {
             pbuf_free(p);
-            return ERR_BUF; // Indicate buffer error
         }
+        http_response.error = true;
+        return ERR_OK;
+    }
 
-        pbuf_copy_partial(p, recv_chunk_buf, p->tot_len, 0);
-        recv_chunk_buf[p->tot_len] = 0;
+    if (p == NULL) {
+        http_response.closed = true;
+        if (http_response.header_len >= 0 && http_response.content_length < 0) {
+            http_response.complete = true;
+        }
+        return ERR_OK;
+    }
 
-        // #ifdef HIGH_VERBOSE_DEBUG
-        debug_log("Buffer= %s\n", recv_chunk_buf);
-        // #endif
+    size_t remaining_space = sizeof(server_response_buf) - http_response.len - 1; // Leave space for null terminator
 
-        strcat(server_response_buf, recv_chunk_buf); // Append chunk to global buffer
+    if (p->tot_len > remaining_space) {
+        debug_log("Buffer overflow risk: received data exceeds buffer size.\n");
         altcp_recved(pcb, p->tot_len);
         pbuf_free(p);
+        http_response.error = true;
+        return ERR_OK; // The pbuf is consumed; ERR_BUF would make lwIP keep the freed pbuf as refused data
+    }
+
+    size_t scan_from = http_response.len;
+    pbuf_copy_partial(p, server_response_buf + http_response.len, p->tot_len, 0);
+    http_response.len += p->tot_len;
+    server_response_buf[http_response.len] = 0;
+
+    #ifdef HIGH_VERBOSE_DEBUG
+    debug_log("Buffer= %s\n", server_response_buf + scan_from);
+    #endif
+
+    altcp_recved(pcb, p->tot_len);
+    pbuf_free(p);
+
+    http_response_parse_header(scan_from);
+
+    if (http_response.header_len >= 0 && http_response.content_length >= 0 &&
+        (int)http_response.len - http_response.header_len >= http_response.content_length) {
+        http_response.complete = true;
     }
     return ERR_OK;
 }
 
+/**
+ * @brief lwIP error callback: the connection was aborted, the pcb is already freed.
+ */
+static void altcp_client_err(void *arg, err_t err) {
+    debug_log_with_color(COLOR_RED, "TCP connection error: %d\n", err);
+    http_pcb = NULL;
+    http_response.error = true;
+}
+
+/**
+ * @brief Closes the HTTP connection if it is still open (aborts if close fails).
+ */
+static void http_close(void) {
+    cyw43_arch_lwip_begin();
+    if (http_pcb != NULL) {
+        altcp_arg(http_pcb, NULL);
+        altcp_recv(http_pcb, NULL);
+        altcp_err(http_pcb, NULL);
+        if (altcp_close(http_pcb) != ERR_OK) {
+            altcp_abort(http_pcb);
+        }
+        http_pcb = NULL;
+    }
+    cyw43_arch_lwip_end();
+}
+
 static err_t altcp_client_connected(void *arg, struct altcp_pcb *pcb, err_t err) {
     const char* header = (const char*)arg; // Cast arg to header
     err = altcp_write(pcb, header, strlen(header), 0);
@@ -469,6 +613,64 @@ seat_info_t parse_seat_info(const char* json) {
     return info;
 }
 
+// Seat data of the last server response, written by core0 before it hands the WifiResult to core1
+static seat_info_t seat_info = { .is_available = true };
+static uint32_t seat_info_as_of = 0;   // RTC minutes of the cached data in `seat_info`, 0 = live
+
+#define SEAT_CACHE_MAX_AGE_MINUTES  (24 * 60)  // Older data is not shown, the error page is
+
+/**
+ * @brief Keeps the seat data of a successful server response for later failures (EEPROM).
+ */
+static void seat_cache_update(uint32_t fetched_at) {
+    seat_cache_data_t* c = &seat_cache.data;
+
+    c->valid = 1;
+    c->is_available = seat_info.is_available;
+    c->fetched_at = fetched_at;
+    strncpy(c->user_email, seat_info.user_email, sizeof(c->user_email) - 1);
+    c->user_email[sizeof(c->user_email) - 1] = 0;
+    strncpy(c->desk_name, seat_info.desk_name, sizeof(c->desk_name) - 1);
+    c->desk_name[sizeof(c->desk_name) - 1] = 0;
+}
+
+/**
+ * @brief Replaces `seat_info` with the cached data after a failed update (stale-while-revalidate).
+ *
+ * @param now RTC minutes since 2000.
+ * @return true if the cache is valid and recent enough to be shown.
+ */
+static bool seat_cache_restore(uint32_t now) {
+    const seat_cache_data_t* c = &seat_cache.data;
+
+    if (!c->valid || now < c->fetched_at || now - c->fetched_at > SEAT_CACHE_MAX_AGE_MINUTES) {
+        return false;
+    }
+
+    seat_info.is_available = c->is_available;
+    strncpy(seat_info.user_email, c->user_email, sizeof(seat_info.user_email));
+    strncpy(seat_info.desk_name, c->desk_name, sizeof(seat_info.desk_name));
+    seat_info_as_of = c->fetched_at;
+    return true;
+}
+
+/**
+ * @brief Returns true if a button page can render from the seat cache of the last scheduled wake.
+ *
+ * The scheduled wake keeps the seat data of its server response in the seat
+ * cache; within the page 0 refresh interval a button wake uses that data and
+ * leaves the cyw43 powered down. Only seat data is cached: a page that needs
+ * any other server data must not be served from here.
+ *
+ * @param now RTC minutes since 2000.
+ */
+static bool seat_cache_fresh(int pushbutton, uint32_t now) {
+    const seat_cache_data_t* c = &seat_cache.data;
+    uint32_t max_age = power_governor_refresh_minutes(device_config_flash.data.refresh_minutes_by_pushbutton[0]);
+
+    return pushbutton != 0 && c->valid && now >= c->fetched_at && now - c->fetched_at <= max_age;
+}
+
 
 /**
  * @brief Configures and reads the state of pushbuttons
@@ -538,6 +740,265 @@ void setup_and_read_pushbuttons() {
     // }
 }
 
+// Set by wifi_connect_start(), the association then runs in the background
+static bool wifi_connect_started = false;
+
+// Fast-reconnect state of the current association (see wifi_cache in eeprom.h)
+static wifi_path_t wifi_path = WIFI_PATH_FULL;
+static bool wifi_directed = false;             // Association directed to the cached BSSID/channel
+static uint32_t wifi_start_minutes = 0;        // RTC time of wifi_connect_start()
+static absolute_time_t wifi_start_time;
+
+/**
+ * @brief Returns true if a static IPv4 address is configured (0.0.0.0 = DHCP).
+ */
+static bool wifi_static_ip_configured(void) {
+    const uint8_t* ip = device_config_flash.data.static_ip;
+    return (ip[0] | ip[1] | ip[2] | ip[3]) != 0;
+}
+
+/**
+ * @brief Starts an association, directed to the cached BSSID/channel if `directed` is set.
+ */
+static int wifi_join(bool directed) {
+    if (directed) {
+        return cyw43_wifi_join(&cyw43_state,
+                               strlen(wifi_config_flash.ssid), (const uint8_t*)wifi_config_flash.ssid,
+                               strlen(wifi_config_flash.password), (const uint8_t*)wifi_config_flash.password,
+                               auth, wifi_cache.data.bssid,
+                               wifi_cache.data.channel ? wifi_cache.data.channel : CYW43_CHANNEL_NONE);
+    }
+    return cyw43_arch_wifi_connect_async(wifi_config_flash.ssid, wifi_config_flash.password, auth);
+}
+
+/**
+ * @brief Switches the cyw43 module on and starts the association with the configured network.
+ *
+ * The call returns immediately; the association runs in the background while the
+ * caller brings up the ePaper panel and renders the static parts of the page.
+ * wifi_wait_for_link() collects the result.
+ *
+ * With `fast_reconnect` enabled and a cache entry for the configured SSID, the
+ * association is directed to the last BSSID/channel (no scan), and a DHCP lease
+ * that has not reached half its lifetime is reused instead of a new DHCP exchange.
+ * A configured static IP always replaces DHCP.
+ *
+ * Uses the RTC time of the boot snapshot (wake_context).
+ *
+ * @return true if the association was started, false if the Wi-Fi chip could not be initialized.
+ */
+bool wifi_connect_start(void) {
+    debug_log_with_color(COLOR_BOLD_GREEN, "Initialization of Wi-Fi [switching cyw43 module on]...\n");
+
+    wifi_start_minutes = wake_context.rtc_minutes;
+
+    wifi_directed = device_config_flash.data.fast_reconnect && wifi_cache.data.ap_valid &&
+        wifi_cache.data.network_crc == calc_crc32(wifi_config_flash.ssid, strlen(wifi_config_flash.ssid));
+
+    if (wifi_static_ip_configured()) {
+        wifi_path = WIFI_PATH_STATIC;
+    } else if (wifi_directed) {
+        wifi_path = (wifi_cache.data.lease_valid && wifi_start_minutes < wifi_cache.data.lease_expiry)
+                    ? WIFI_PATH_FAST_LEASE : WIFI_PATH_FAST;
+    } else {
+        wifi_path = WIFI_PATH_FULL;
+    }
+
+    wifi_start_time = get_absolute_time();
+
+    if (cyw43_arch_init_with_country(country)) {
+        debug_log_with_color(COLOR_RED, "Wi-Fi initialization failed.\n");
+        return false;
+    }
+    cyw43_arch_enable_sta_mode();
+
+    // The station MAC seeds the per-device wake phase (wake_scheduler.c)
+    if (cyw43_wifi_get_mac(&cyw43_state, CYW43_ITF_STA, mac_address) == 0) {
+        memcpy(wake_state.data.mac, mac_address, sizeof(wake_state.data.mac));
+    }
+
+    if (device_config_flash.data.roomname != NULL) {
+        netif_set_hostname(netif_default, device_config_flash.data.roomname);
+    }
+
+    if (wifi_directed) {
+        debug_log("Directed association to %02X:%02X:%02X:%02X:%02X:%02X, channel %d%s\n",
+                  wifi_cache.data.bssid[0], wifi_cache.data.bssid[1], wifi_cache.data.bssid[2],
+                  wifi_cache.data.bssid[3], wifi_cache.data.bssid[4], wifi_cache.data.bssid[5],
+                  wifi_cache.data.channel, (wifi_path == WIFI_PATH_FAST_LEASE) ? ", reusing DHCP lease" : "");
+    } else {
+        debug_log("Attempt to connect to the specified network (async)...\n");
+    }
+
+    if (wifi_join(wifi_directed) != 0) {
+        debug_log_with_color(COLOR_RED, "Failed to start Wi-Fi association.\n");
+        cyw43_arch_deinit();
+        return false;
+    }
+
+    wifi_connect_started = true;
+    return true;
+}
+
+/**
+ * @brief Configures the cached lease or the static IP once the link is associated.
+ *
+ * The cyw43 lwIP glue starts DHCP on link-up, so a DISCOVER is usually already
+ * on air; dhcp_stop() ends the exchange before a REQUEST is sent, which saves the
+ * wait for the server but not all DHCP traffic.
+ */
+static void wifi_apply_known_address(void) {
+    ip4_addr_t ip, netmask, gw;
+
+    if (wifi_static_ip_configured()) {
+        const device_config_data_t* cfg = &device_config_flash.data;
+        IP4_ADDR(&ip, cfg->static_ip[0], cfg->static_ip[1], cfg->static_ip[2], cfg->static_ip[3]);
+        IP4_ADDR(&netmask, cfg->static_netmask[0], cfg->static_netmask[1], cfg->static_netmask[2], cfg->static_netmask[3]);
+        IP4_ADDR(&gw, cfg->static_gateway[0], cfg->static_gateway[1], cfg->static_gateway[2], cfg->static_gateway[3]);
+    } else {
+        ip4_addr_set_u32(&ip, wifi_cache.data.ip);
+        ip4_addr_set_u32(&netmask, wifi_cache.data.netmask);
+        ip4_addr_set_u32(&gw, wifi_cache.data.gateway);
+    }
+
+    cyw43_arch_lwip_begin();
+    dhcp_stop(netif_default);
+    netif_set_addr(netif_default, &ip, &netmask, &gw);
+    cyw43_arch_lwip_end();
+}
+
+/**
+ * @brief Stores the access point and DHCP lease of a successful association in `wifi_cache`.
+ *
+ * The record is written to the EEPROM later by save_wifi_cache() (core0, after core1 is done).
+ */
+static void wifi_update_cache(uint32_t time_to_associate_ms, uint32_t time_to_ip_ms) {
+    wifi_cache_data_t* c = &wifi_cache.data;
+
+    c->network_crc = calc_crc32(wifi_config_flash.ssid, strlen(wifi_config_flash.ssid));
+    c->ap_valid = (cyw43_wifi_get_bssid(&cyw43_state, c->bssid) == 0);
+
+    uint32_t channel_info[3] = {0};
+    if (cyw43_ioctl(&cyw43_state, CYW43_IOCTL_GET_CHANNEL, sizeof(channel_info), (uint8_t*)channel_info, CYW43_ITF_STA) == 0) {
+        c->channel = (uint8_t)channel_info[0];
+    } else {
+        c->channel = 0;
+    }
+
+    if (wifi_path != WIFI_PATH_FAST_LEASE && wifi_path != WIFI_PATH_STATIC) {
+        struct dhcp* dhcp = netif_dhcp_data(netif_default);
+        c->lease_valid = 0;
+        if (dhcp != NULL && dhcp_supplied_address(netif_default) && dhcp->offered_t0_lease > 0) {
+            c->ip = ip4_addr_get_u32(netif_ip4_addr(netif_default));
+            c->netmask = ip4_addr_get_u32(netif_ip4_netmask(netif_default));
+            c->gateway = ip4_addr_get_u32(netif_ip4_gw(netif_default));
+            c->lease_expiry = wifi_start_minutes + dhcp->offered_t0_lease / 120; // Half the lease, in minutes
+            c->lease_valid = 1;
+        }
+    }
+
+    c->last_path = wifi_path;
+    c->time_to_associate_ms = (uint16_t)MIN(time_to_associate_ms, UINT16_MAX);
+    c->time_to_ip_ms = (uint16_t)MIN(time_to_ip_ms, UINT16_MAX);
+}
+
+/**
+ * @brief Drops a reused DHCP lease after a failed server exchange (address may be taken),
+ *        so the next wake runs DHCP again.
+ */
+static void wifi_forget_reused_lease(void) {
+    if (wifi_path == WIFI_PATH_FAST_LEASE) {
+        wifi_cache.data.lease_valid = 0;
+    }
+}
+
+/**
+ * @brief Waits until the association started by wifi_connect_start() has an IP address.
+ *
+ * Every attempt gets `wifi_timeout` ms; on failure or timeout the association is
+ * restarted until `number_wifi_attempts` is reached (both capped in the low-battery
+ * tiers, see power_governor.c; a single attempt after two failed wakes in a row). A failed fast-reconnect
+ * attempt falls back to the full scan/associate/DHCP path.
+ *
+ * @return true if the link is up, false otherwise (the cyw43 module is still on).
+ */
+static bool wifi_wait_for_link(void) {
+    int wifi_attempt_count = 1;
+    int64_t associated_us = -1;
+
+    // During an ongoing outage one attempt per wake is enough, the retry backoff does the rest
+    int max_attempts = power_governor_wifi_attempts(device_config_flash.data.number_wifi_attempts);
+    if (wake_state.data.failure_streak >= 2) {
+        max_attempts = 1;
+    }
+
+    clock_policy_wait(); // Polling the link status needs no speed
+
+    while (true) {
+        absolute_time_t deadline = make_timeout_time_ms(power_governor_wifi_timeout_ms(device_config_flash.data.wifi_timeout));
+        int status = CYW43_LINK_DOWN;
+        bool address_applied = false;
+
+        while (!time_reached(deadline)) {
+            status = cyw43_tcpip_link_status(&cyw43_state, CYW43_ITF_STA);
+            if (status == CYW43_LINK_NOIP || status == CYW43_LINK_UP) {
+                if (associated_us < 0) {
+                    associated_us = absolute_time_diff_us(wifi_start_time, get_absolute_time());
+                }
+                if (status == CYW43_LINK_NOIP && !address_applied &&
+                    (wifi_path == WIFI_PATH_FAST_LEASE || wifi_static_ip_configured())) {
+                    wifi_apply_known_address();
+                    address_applied = true;
+                    continue;
+                }
+            }
+            if (status == CYW43_LINK_UP || status == CYW43_LINK_FAIL ||
+                status == CYW43_LINK_NONET || status == CYW43_LINK_BADAUTH) {
+                break;
+            }
+            sleep_ms(10);
+            watchdog_update();
+        }
+
+        if (status == CYW43_LINK_UP) {
+            int64_t ip_us = absolute_time_diff_us(wifi_start_time, get_absolute_time());
+            debug_log_with_color(COLOR_GREEN, "Wi-Fi path %d: associated after %lld ms, IP after %lld ms\n",
+                                 wifi_path, associated_us / 1000, ip_us / 1000);
+            wifi_update_cache((uint32_t)(associated_us / 1000), (uint32_t)(ip_us / 1000));
+            return true;
+        }
+
+        debug_log_with_color(COLOR_YELLOW, "Trying to connect to %s ... Attempt %d (link status %d)\n",
+                             wifi_config_flash.ssid, wifi_attempt_count, status);
+
+        if (wifi_attempt_count >= max_attempts) {
+            debug_log_with_color(COLOR_RED, "Failed to connect to Wi-Fi after %d attempts.\n", wifi_attempt_count);
+            wifi_cache.data.ap_valid = 0;
+            wifi_cache.data.lease_valid = 0;
+            return false;
+        }
+        wifi_attempt_count++;
+        associated_us = -1;
+
+        // Cached AP/lease did not work: forget it and use the full path
+        if (wifi_directed) {
+            debug_log_with_color(COLOR_YELLOW, "Fast reconnect failed, falling back to full association\n");
+            wifi_cache.data.ap_valid = 0;
+            wifi_cache.data.lease_valid = 0;
+            wifi_directed = false;
+            if (wifi_path != WIFI_PATH_STATIC) {
+                wifi_path = WIFI_PATH_FULL;
+            }
+        }
+
+        cyw43_wifi_leave(&cyw43_state, CYW43_ITF_STA);
+        if (wifi_join(wifi_directed) != 0) {
+            return false;
+        }
+        watchdog_update();
+    }
+}
+
 /**
  * @brief Communicates with the server via Wi-Fi.
  *
@@ -560,58 +1021,42 @@ void setup_and_read_pushbuttons() {
  * @note
  * - The function uses the global `server_response_buf` buffer to store server responses. Ensure this
  *   buffer is adequately sized and initialized before calling this function.
- * - The `recv_chunk_buf` buffer is used for intermediate processing of incoming chunks of server_response_buf.
+ * - The receive state (`http_response`) is updated by the `recv` callback; the function blocks on it
+ *   with a deadline of `max_wait_data_wifi` x 50 ms and switches the radio off as soon as the body is complete.
  * - This function assumes a single-threaded context. In multi-threaded environments, additional
  *   synchronization mechanisms are required to avoid race conditions.
  *
  * @see
  * - `WifiResult`: Enum for Wi-Fi operation results.
- * - `server_response_buf`, `recv_chunk_buf`: Global buffers used for processing and storing data.
+ * - `server_response_buf`, `http_response`: Global buffer and receive state of the response.
  * - `cyw43_arch.h`: SDK header for Wi-Fi functions.
  */
 
 WifiResult wifi_server_communication(float voltage) {
-    memset(recv_chunk_buf, 0, sizeof(recv_chunk_buf));
     memset(server_response_buf, 0, sizeof(server_response_buf));
+    memset(&http_response, 0, sizeof(http_response));
+    http_response.header_len = -1;
+    http_response.content_length = -1;
 
-    debug_log_with_color(COLOR_BOLD_GREEN, "Initialization of Wi-Fi [switching cyw43 module on]...\n");
-
-    if (cyw43_arch_init_with_country(country)) {
-        debug_log_with_color(COLOR_RED, "Wi-Fi initialization failed.\n");
+    if (!wifi_connect_started && !wifi_connect_start()) {
         return WIFI_ERROR_CONNECTION;
     }
-    cyw43_arch_enable_sta_mode();
-
-    if (device_config_flash.data.roomname != NULL) {
-        netif_set_hostname(netif_default, device_config_flash.data.roomname);
-    }
+    wifi_connect_started = false;
 
     watchdog_update();
-    debug_log("Attempt to connect to the specified network...\n");
 
-    int wifi_connected = -1;
-    int wifi_attempt_count = 0;
-    while (wifi_connected != 0 && wifi_attempt_count < device_config_flash.data.number_wifi_attempts) {
-        wifi_attempt_count++;
-        wifi_connected = cyw43_arch_wifi_connect_timeout_ms(
-            wifi_config_flash.ssid,
-            wifi_config_flash.password,
-            auth,
-            device_config_flash.data.wifi_timeout
-        );
-        watchdog_update();
-        // debug_log_with_color(COLOR_YELLOW, "ssid %s\n", wifi_config_flash.ssid);
-
-        debug_log_with_color(COLOR_YELLOW, "Trying to connect to %s ... Attempt %d\n", wifi_config_flash.ssid, wifi_attempt_count);
-    }
-
-    if (wifi_connected != 0) {
-        debug_log_with_color(COLOR_RED, "Failed to connect to Wi-Fi after %d attempts.\n", wifi_attempt_count);
+    wake_metrics_begin(WAKE_PHASE_WIFI_ASSOCIATE);
+    bool linked = wifi_wait_for_link();
+    wake_metrics_end(WAKE_PHASE_WIFI_ASSOCIATE);
+    if (!linked) {
         cyw43_arch_deinit();
         return WIFI_ERROR_CONNECTION;
     }
     debug_log("Connected to Wi-Fi successfully.\n");
 
+    // The SNTP reply arrives while the server request is in flight (see time_sync.h)
+    time_sync_start();
+
     // Build "username:password" string for HTTP Basic Auth
     char userpass[128];
     snprintf(userpass, sizeof(userpass), "%s:%s", seatsurfing_config_flash.data.username, seatsurfing_config_flash.data.password);
@@ -620,25 +1065,38 @@ WifiResult wifi_server_communication(float voltage) {
     char auth_b64[192];  // Safe size: 4/3 * 128 + null terminator
     base64_encode(userpass, strlen(userpass), auth_b64, sizeof(auth_b64));
 
+    // Booking window for the wake scheduler (ignored by servers that do not support it)
+    char query[128] = "";
+    if (device_config_flash.data.wake_ceiling_minutes > 0) {
+        char enter[40], leave[40];
+        wake_scheduler_format_time(wifi_start_minutes, enter, sizeof(enter));
+        wake_scheduler_format_time(wifi_start_minutes + WAKE_SCHEDULER_WINDOW_MINUTES, leave, sizeof(leave));
+        snprintf(query, sizeof(query), "?enter=%s&leave=%s", enter, leave);
+    }
+
+    // Wake records of previous cycles (ignored by servers that do not support it)
+    char wake_log[512];
+    wake_metrics_format_upload(wake_log, sizeof(wake_log));
+
     // Construct HTTP/1.0 request including the dynamically generated Authorization header
-    char header[1024];
+    char header[1536];
     snprintf(header, sizeof(header),
-            "GET /location/%s/space/%s/availability HTTP/1.0\r\n"
+            "GET /location/%s/space/%s/availability%s HTTP/1.0\r\n"
             "Host: %s\r\n"
             "Authorization: Basic %s\r\n"
+            "%s"
             "\r\n",
             seatsurfing_config_flash.data.location_id,
             seatsurfing_config_flash.data.space_id,
+            query,
             seatsurfing_config_flash.data.host,
-            auth_b64
+            auth_b64,
+            wake_log
     );
 
     debug_log("Constructed HTTP Header:\n%s\n", header);
     watchdog_update();
 
-    struct altcp_pcb* pcb = altcp_new(NULL);
-    altcp_recv(pcb, recv);
-
     ip_addr_t ip;
     // IP4_ADDR(&ip, device_config_flash.data.ip[0], device_config_flash.data.ip[1], device_config_flash.data.ip[2], device_config_flash.data.ip[3]);
     IP4_ADDR(&ip,
@@ -647,11 +1105,24 @@ WifiResult wifi_server_communication(float voltage) {
              seatsurfing_config_flash.data.ip[2],
              seatsurfing_config_flash.data.ip[3]);
 
-    altcp_arg(pcb, header);
-    err_t err = altcp_connect(pcb, &ip, seatsurfing_config_flash.data.port, altcp_client_connected);
+    wake_metrics_begin(WAKE_PHASE_HTTP);
+    cyw43_arch_lwip_begin();
+    http_pcb = altcp_new(NULL);
+    err_t err = ERR_MEM;
+    if (http_pcb != NULL) {
+        altcp_arg(http_pcb, header);
+        altcp_recv(http_pcb, recv);
+        altcp_err(http_pcb, altcp_client_err);
+        err = altcp_connect(http_pcb, &ip, seatsurfing_config_flash.data.port, altcp_client_connected);
+    }
+    cyw43_arch_lwip_end();
 
     if (err != ERR_OK) {
+        wake_metrics_end(WAKE_PHASE_HTTP);
         debug_log_with_color(COLOR_RED, "TCP connection failed: %d\n", err);
+        wifi_forget_reused_lease();
+        time_sync_stop();
+        http_close();
         cyw43_arch_disable_sta_mode();
         cyw43_arch_deinit();
         return WIFI_ERROR_SERVER;
@@ -661,65 +1132,44 @@ WifiResult wifi_server_communication(float voltage) {
 
     watchdog_update();
 
-    // Wait for complete HTTP header
-    int max_waits = 0;
-    int content_length = -1;
-    int body_received = 0;
-    bool header_done = false;
-
-    debug_log_with_color(COLOR_YELLOW, "50 ms wait time for header/body #: ");
-    while (max_waits++ < device_config_flash.data.max_wait_data_wifi) {
-        sleep_ms(50);
-        debug_log_with_color(COLOR_YELLOW, " ");
-
-        char* header_end = strstr(server_response_buf, "\r\n\r\n");
-        if (!header_done && header_end) {
-            header_done = true;
-
-            // Parse Content-Length
-            char* cl = strstr(server_response_buf, "Content-Length:");
-            if (cl) {
-                cl += strlen("Content-Length:");
-                while (*cl == ' ') cl++;
-                content_length = atoi(cl);
-                debug_log("Parsed Content-Length: %d\n", content_length);
-            } else {
-                // debug_log_with_color(COLOR_RED, "No Content-Length found.\n");
-                break;
-            }
-        }
-
-        if (header_done && content_length > 0) {
-            char* body = strstr(server_response_buf, "\r\n\r\n");
-            if (body) {
-                body += 4; // Skip past "\r\n\r\n"
-                body_received = strlen(body);
+    // Wait until the recv callback reports the complete body, a close or an error.
+    // The deadline keeps the former budget of max_wait_data_wifi x 50 ms (capped in the low-battery tiers).
+    absolute_time_t deadline = make_timeout_time_ms(power_governor_http_wait_ms(device_config_flash.data.max_wait_data_wifi * 50));
+    absolute_time_t start = get_absolute_time();
 
-                if (body_received >= content_length) {
-                    debug_log("Received full JSON body (%d bytes)\n", body_received);
-                    break;
-                }
-            }
-        }
+    clock_policy_wait();
+    while (!http_response.complete && !http_response.closed && !http_response.error &&
+           !time_reached(deadline)) {
+        absolute_time_t slice = make_timeout_time_ms(100);
+        cyw43_arch_wait_for_work_until(absolute_time_diff_us(slice, deadline) < 0 ? slice : deadline);
         watchdog_update();
     }
 
+    wake_metrics_end(WAKE_PHASE_HTTP);
+
+    // Radio off as soon as the response is in
+    time_sync_stop();
+    http_close();
     cyw43_arch_disable_sta_mode();
     cyw43_arch_deinit();
 
-    if (content_length <= 0 || body_received < content_length) {
-        debug_log_with_color(COLOR_RED, "Incomplete or missing response.\n");
+    if (!http_response.complete) {
+        wifi_forget_reused_lease();
+        debug_log_with_color(COLOR_RED, "Incomplete or missing response after %lld ms.\n",
+                             absolute_time_diff_us(start, get_absolute_time()) / 1000);
         return WIFI_ERROR_SERVER;
     }
 
+    debug_log("Received full body (%d bytes) after %lld ms\n",
+              (int)http_response.len - http_response.header_len,
+              absolute_time_diff_us(start, get_absolute_time()) / 1000);
     debug_log_with_color(COLOR_BOLD_GREEN, "✅ JSON response complete - Wi-Fi off.\n");
 
-    // Optional: Übergib JSON zur Auswertung
-    const char* body = strstr(server_response_buf, "\r\n\r\n");
-    if (body) {
-        body += 4;
-       // parse_json_response(body);  // <--- Implementiere je nach Bedarf
-    }
+    // Parse on the networking core, the render core only gets the result
+    clock_policy_run();
+    seat_info = parse_seat_info(server_response_buf);
+    wake_scheduler_parse_bookings(server_response_buf, &booking_schedule);
+    wake_metrics_upload_done();
 
     return WIFI_SUCCESS;
 }
@@ -739,14 +1189,8 @@ WifiResult wifi_server_communication(float voltage) {
 float read_battery_voltage(float conversion_factor) {
     // debug_log("Reading battery voltage...");
 
-    // Initialize ADC
-    adc_init();
-    adc_gpio_init(26);      // Initialize GPIO26 for ADC
-    adc_select_input(0);    // Select ADC input 0 (GPIO26)
-
-    // Read ADC value
-    uint16_t adc_result = adc_read();
-    float voltage = adc_result * conversion_factor;
+    // Oversampled via DMA (see wake_context.c)
+    float voltage = wake_context_adc_read(WAKE_CONTEXT_BATTERY_GPIO, conversion_factor);
 
     debug_log("Battery voltage: %.3f V\n", voltage);
     fflush(stdout);
@@ -767,7 +1211,7 @@ float read_battery_voltage(float conversion_factor) {
  * - The measured coin cell voltage (float).
  */
 float read_coin_cell_voltage(float conversion_factor) {
-    const uint gpio_mosfet = 14;  // GP14 controls the MOSFET
+    const uint gpio_mosfet = WAKE_CONTEXT_DIVIDER_GPIO;  // GP14 controls the MOSFET
 
     // debug_log("Reading coin cell voltage...");
 
@@ -779,14 +1223,8 @@ float read_coin_cell_voltage(float conversion_factor) {
     gpio_put(gpio_mosfet, 1);
     sleep_ms(5);  // Small delay to allow voltage to stabilize
 
-    // Initialize ADC
-    adc_init();
-    adc_gpio_init(27);      // Initialize GPIO27 for ADC
-    adc_select_input(1);    // Select ADC input 1 (GPIO27)
-
-    // Read ADC value
-    uint16_t adc_result = adc_read();
-    float voltage = adc_result * conversion_factor;
+    // Oversampled via DMA (see wake_context.c)
+    float voltage = wake_context_adc_read(WAKE_CONTEXT_COIN_CELL_GPIO, conversion_factor);
 
     // Turn OFF the MOSFET after reading
     gpio_put(gpio_mosfet, 0);
@@ -953,78 +1391,31 @@ void set_rtc_from_display_string(ds3231_t* ds3231, const char* line) {
  *
  * @details
  * - The RTC holds regional **standard time** (e.g., MEZ), not UTC.
- * - If `query_only_at_officehours` is enabled in the room configuration, the wake-up time is
- *   adjusted to fall within office hours (6:00 AM to 7:00 PM), and operation is skipped on
- *   Saturdays and Sundays.
- * - The RTC alarm is configured in standard time by converting the calculated local alarm
- *   time (which includes DST) back to standard time if necessary.
- * - A safe modulo-based time calculation ensures refresh intervals > 60 min are handled correctly.
+ * - The wake-up time is computed by wake_scheduler_next_alarm(): at the next booking
+ *   change for the default page, the fixed page interval otherwise, moved to the next
+ *   window of the weekly schedule if `query_only_at_officehours` is enabled.
+ * - Alarm 2 matches date, hour and minute, so weekends and closures are slept through.
+ * - In the shutdown power tier no alarm is set at all.
  * - The gate pin is reset to high impedance, enabling the RTC to control the power state.
  */
 void set_alarmclock_and_powerdown(ds3231_t* ds3231) {
     ds3231_data_t current_time;
     ds3231_read_current_time(ds3231, &current_time);
 
-    // Convert RTC standard time to local time (with DST)
-    int local_hour = current_time.hours;
-    int local_minute = current_time.minutes;
-    int day = current_time.day; // 1 = Monday, 7 = Sunday
-
-    bool dst_active = is_dst_europe(&current_time);
-    if (dst_active) {
-        local_hour += 1;
-        if (local_hour >= 24) {
-            local_hour -= 24;
-            day = (day % 7) + 1; // wrap weekday 1–7
-        }
-    }
-
-    // Calculate next wake-up time (safe for refresh_minutes ≥ 60)
-    // int total_minutes = local_hour * 60 + local_minute + device_config_flash.data.refresh_minutes;
-    int refresh = device_config_flash.data.refresh_minutes_by_pushbutton[pushbutton & 0x07]; // use only 3 bits
-    int total_minutes = local_hour * 60 + local_minute + refresh;
-    int alarm_hour = (total_minutes / 60) % 24;
-    int alarm_minute = total_minutes % 60;
-
-    // Adjust wake-up time based on office hours configuration
-    if (device_config_flash.data.query_only_at_officehours) {
-        // Skip operation on Saturdays (6) and Sundays (7)
-        if (day == 6 || day == 7) {
-            debug_log("Skipping operation: Weekend detected.\n");
-            alarm_hour = 6;
-            alarm_minute = 0;
-            day = (day == 6) ? 7 : 1; // move to next day
-        }
-
-        // Clamp alarm to office hours (6:00 to 19:00)
-        if (alarm_hour >= 19 || alarm_hour < 6) {
-            alarm_hour = 6;
-            alarm_minute = 0;
-        }
-    }
+    if (power_governor_tier() == POWER_TIER_SHUTDOWN) {
+        // Batteries empty: the device only starts again on a button press
+        ds3231_enable_alarm_interrupt(ds3231, false);
+        debug_log_with_color(COLOR_RED, "Battery below switch-off voltage, no wake-up scheduled\n");
+    } else {
+        // Next wake from the booking data or the fixed page interval (see wake_scheduler.c)
+        ds3231_alarm_2_t alarm2;
+        wake_scheduler_next_alarm(&current_time, pushbutton, &alarm2);
 
-    // Convert alarm time from local time back to standard time (RTC base)
-    if (dst_active) {
-        alarm_hour -= 1;
-        if (alarm_hour < 0) {
-            alarm_hour += 24;
-            // optional: decrement day if needed
-        }
+        ds3231_enable_alarm_interrupt(ds3231, true);
+        ds3231_set_alarm_2(ds3231, &alarm2, ON_MATCHING_MINUTE_HOUR_AND_DATE);
+        debug_log("Alarm2 set for date %02d, %02d:%02d (RTC time)\n", alarm2.date, alarm2.hours, alarm2.minutes);
     }
 
-    // Configure the RTC alarm
-    ds3231_alarm_2_t alarm2 = {
-        .minutes = alarm_minute,
-        .hours = alarm_hour,
-        .date = 0,
-        .day = 0,
-        .am_pm = false
-    };
-
-    ds3231_enable_alarm_interrupt(ds3231, true);
-    ds3231_set_alarm_2(ds3231, &alarm2, ON_MATCHING_MINUTE_AND_HOUR);
-    debug_log("Alarm2 set for %02d:%02d (RTC time)\n", alarm2.hours, alarm2.minutes);
-
     sleep_ms(5);
 
     // Reset the gate pin to high impedance to allow the RTC to control power
@@ -1060,19 +1451,140 @@ bool draw_flash_logo(UBYTE* buffer, int x, int y) {
     return true;
 }
 
-UBYTE* init_epaper() {
+/**
+ * @brief Returns the size of the 1-bit framebuffer for the configured ePaper type.
+ *
+ * @return Buffer size in bytes, or 0 if the ePaper type is not supported.
+ */
+UWORD get_epaper_image_size(void) {
+    return (UWORD)epd_driver_image_size(epd_driver_current());
+}
+
+// Panel state between epaper_prepare_panel(), init_epaper_panel() and epaper_sleep_panel()
+static bool epaper_module_on = false;    // DEV_Module_Init() done
+static bool epaper_panel_ready = false;  // Controller initialized, waiting for a frame
+static bool epaper_panel_fast = false;   // Controller initialized with the fast waveform
+static uint32_t epaper_pixels_shown_ms = 0; // Time since power-on when the last refresh completed
+
+// A refresh keeps BUSY up for seconds; a shorter BUSY phase means the controller missed the frame
+#define EPAPER_MIN_REFRESH_BUSY_MS 100
 
+/**
+ * @brief Panel SPI clock for this wake.
+ *
+ * epaper_spi_khz from the device configuration (0 = panel maximum), capped at
+ * the controller limit of the panel driver. A clock that failed the refresh check on an earlier
+ * wake (see epaper_finalize_and_powerdown()) is replaced by DEV_SPI_DEFAULT_HZ
+ * until the configuration asks for a different one.
+ */
+static uint32_t epaper_spi_hz(void) {
+    const epd_driver_t* drv = epd_driver_current();
+    uint32_t max_hz = drv ? drv->max_spi_hz : DEV_SPI_DEFAULT_HZ;
+    uint32_t hz = device_config_flash.data.epaper_spi_khz > 0 ? (uint32_t)device_config_flash.data.epaper_spi_khz * 1000u : max_hz;
+
+    if (hz > max_hz) {
+        hz = max_hz;
+    }
+    if (wake_state.data.spi_fallback_khz != 0 && wake_state.data.spi_fallback_khz == hz / 1000u) {
+        hz = DEV_SPI_DEFAULT_HZ;
+    }
+    return hz;
+}
+
+/**
+ * @brief Powers up the ePaper interface at the panel SPI clock, once per wake cycle.
+ *
+ * @return true if the interface is up, false otherwise.
+ */
+static bool epaper_module_power_on(void) {
+    if (epaper_module_on) {
+        return true;
+    }
+
+    DEV_SPI_Set_Baudrate(epaper_spi_hz()); // Bus still down: recorded, DEV_Module_Init() starts it at this clock
+    if (DEV_Module_Init() != 0) {
+        debug_log("Error initializing ePaper hardware module.\n");
+        return false;
+    }
+    epaper_module_on = true;
+    debug_log("Panel bus at %lu kHz (%s)\n", (unsigned long)(DEV_SPI_Get_Baudrate() / 1000), DEV_SPI_PIO ? "pio" : "spi1");
+    return true;
+}
+
+/**
+ * @brief Resets the panel controller and loads the waveform for the next refresh.
+ *
+ * @param fast Use the fast waveform (ignored for panels without EPD_CAP_FAST).
+ * @return true on success, false for unsupported panel types.
+ */
+static bool epaper_init_controller(bool fast) {
+    const epd_driver_t* drv = epd_driver_current();
+    if (drv == NULL) {
+        debug_log("Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
+        return false;
+    }
+
+    fast = fast && epd_driver_has(drv, EPD_CAP_FAST);
+    debug_log("Initializing %s ePaper%s...\n", drv->name, fast ? " (fast waveform)" : "");
+    drv->init(fast);
+
+    epaper_panel_ready = true;
+    epaper_panel_fast = fast;
+    return true;
+}
+
+/**
+ * @brief Brings the panel up speculatively while the Wi-Fi association is still running.
+ *
+ * Powers the ePaper interface and runs the controller reset/init with the full
+ * waveform, which serves full and partial refreshes. init_epaper_panel() reuses
+ * this state and only re-initializes if the refresh policy picks another waveform.
+ * Button wakes load the fast waveform (core0, while core1 draws the page).
+ *
+ * @param fast Initialize with the fast waveform (4.2" V2 only).
+ * @return true if the panel is initialized, false otherwise.
+ */
+bool epaper_prepare_panel(bool fast) {
     if (device_config_flash.data.epapertype == EPAPER_NONE) {
-        debug_log("No ePaper configured for this room.\n");
-        return NULL;
+        return false;
     }
 
     watchdog_update();
 
+    if (!epaper_module_power_on()) {
+        return false;
+    }
+
+    bool ok = epaper_init_controller(fast);
+    watchdog_update();
+    return ok;
+}
+
+/**
+ * @brief Powers up the ePaper interface and initializes the panel controller.
+ *
+ * Only called once it is clear that the panel actually has to be refreshed.
+ * Wakes with an unchanged frame never run a refresh waveform, but on online
+ * wakes the controller may already have been reset and initialized by
+ * epaper_prepare_panel(); that panel is put back to sleep without a refresh.
+ * By default the controller registers are initialized only and the following
+ * Display call draws the new frame directly (one full waveform instead of two).
+ *
+ * If epaper_prepare_panel() already initialized the controller with the
+ * required waveform, the reset and init sequence is skipped.
+ *
+ * @param plan Refresh plan (see epaper_refresh.h): waveform and deghosting clear.
+ * @return true if the panel is ready to receive a frame, false otherwise.
+ */
+bool init_epaper_panel(const epaper_refresh_plan_t* plan) {
+    const bool clear_first = plan->clear_first;
+    const bool fast = (plan->mode == EPAPER_REFRESH_FAST);
+
+    watchdog_update();
+
     // Initialize the hardware module for the ePaper
-    if (DEV_Module_Init() != 0) {
-        debug_log("Error initializing ePaper hardware module.\n");
-        return NULL;
+    if (!epaper_module_power_on()) {
+        return false;
     }
 
     // Disable the watchdog temporarily for long operations
@@ -1081,50 +1593,90 @@ UBYTE* init_epaper() {
     #endif
     hw_clear_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS);
 
-    UWORD Imagesize = 0;
+    if (epaper_panel_ready && epaper_panel_fast == fast) {
+        debug_log("ePaper controller already initialized during Wi-Fi association\n");
+    } else if (!epaper_init_controller(fast)) {
+        hw_set_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS); // Re-enable watchdog
+        return false;
+    }
 
-    // Initialize and clear the ePaper based on the configured type
-    switch (device_config_flash.data.epapertype) {
-        case EPAPER_WAVESHARE_7IN5_V2:
-            debug_log("Initializing Waveshare 7.5-inch V2 ePaper...\n");
-            EPD_7IN5_V2_Init();
-            EPD_7IN5_V2_Clear();
-            Imagesize = ((EPD_7IN5_V2_WIDTH % 8 == 0) ? (EPD_7IN5_V2_WIDTH / 8) : (EPD_7IN5_V2_WIDTH / 8 + 1)) * EPD_7IN5_V2_HEIGHT;
-            break;
+    if (clear_first) {
+        debug_log("Deghosting: clearing ePaper before refresh\n");
+        if (!epd_driver_current()->clear()) { // Controller init succeeded, so the driver exists
+            debug_log_with_color(COLOR_RED, "ePaper BUSY timeout during the deghosting clear\n");
+            hw_set_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS); // Re-enable watchdog
+            return false;
+        }
+    }
 
-        case EPAPER_WAVESHARE_4IN2_V2:
-            debug_log("Initializing Waveshare 4.2-inch ePaper...\n");
-            EPD_4IN2_V2_Init();
-            EPD_4IN2_V2_Clear();
-            Imagesize = ((EPD_4IN2_V2_WIDTH % 8 == 0) ? (EPD_4IN2_V2_WIDTH / 8) : (EPD_4IN2_V2_WIDTH / 8 + 1)) * EPD_4IN2_V2_HEIGHT;
-            break;
+    // Re-enable the watchdog after setup
+    #ifdef HIGH_VERBOSE_DEBUG
+    debug_log("Re-enabling watchdog...\n");
+    #endif
+
+    watchdog_enable(device_config_flash.data.watchdog_time, 0);
+    watchdog_update();
+    return true;
+}
+
+/**
+ * @brief Puts the panel into deep sleep and powers the ePaper interface down.
+ *
+ * Does nothing if the interface was never powered up in this wake cycle.
+ *
+ * @return true on success, false for unsupported panel types.
+ */
+bool epaper_sleep_panel(void) {
+    if (!epaper_module_on) {
+        return true;
+    }
+
+    // Put the e-Paper display into sleep mode based on the type
+    #ifdef HIGH_VERBOSE_DEBUG
+    debug_log("Entering ePaper sleep mode for type: %d\n", device_config_flash.data.epapertype);
+    #endif
+
+    const epd_driver_t* drv = epd_driver_current();
+    if (drv == NULL) {
+        debug_log_with_color(COLOR_RED, "Unsupported ePaper type during sleep: %d\n", device_config_flash.data.epapertype);
+        return false;
+    }
+    drv->sleep();
+
+    // Short delay to ensure the sleep command is processed
+    DEV_Delay_ms(200);
+
+    // Proceed with complete power-off sequence
+    #ifdef HIGH_VERBOSE_DEBUG
+    debug_log("Shutting down the ePaper module...\n");
+    #endif
+    DEV_Module_Exit();
+    epaper_module_on = false;
+    epaper_panel_ready = false;
+    watchdog_update();
+    return true;
+}
 
-        case EPAPER_WAVESHARE_2IN9_V2:
-            debug_log("Initializing Waveshare 2.9-inch V2 ePaper...\n");
-            EPD_2IN9_V2_Init();
-            EPD_2IN9_V2_Clear();
-            Imagesize = ((EPD_2IN9_V2_WIDTH % 8 == 0) ? (EPD_2IN9_V2_WIDTH / 8) : (EPD_2IN9_V2_WIDTH / 8 + 1)) * EPD_2IN9_V2_HEIGHT;
-            break;
+UBYTE* init_epaper() {
 
-        default:
-            debug_log("Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
-            hw_set_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS); // Re-enable watchdog
-            return NULL;
+    if (device_config_flash.data.epapertype == EPAPER_NONE) {
+        debug_log("No ePaper configured for this room.\n");
+        return NULL;
     }
 
-    // Re-enable the watchdog after setup
-    #ifdef HIGH_VERBOSE_DEBUG
-    debug_log("Re-enabling watchdog...\n");
-    #endif
-
-    watchdog_enable(device_config_flash.data.watchdog_time, 0);
     watchdog_update();
 
+    const epd_driver_t* drv = epd_driver_current();
+    if (drv == NULL) {
+        debug_log("Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
+        return NULL;
+    }
+    UDOUBLE Imagesize = epd_driver_image_size(drv);
+
     // Create a new image cache
     UBYTE *BlackImage = (UBYTE *)malloc(Imagesize);
     if (BlackImage == NULL) {
         debug_log_with_color(COLOR_RED, "Failed to allocate memory for the image cache.\r\n");
-        hw_set_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS); // Ensure watchdog is re-enabled
         return NULL;
     }
 
@@ -1132,10 +1684,7 @@ UBYTE* init_epaper() {
     debug_log("Creating new image...\n");
     #endif
 
-    Paint_NewImage(BlackImage,
-                   (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) ? EPD_7IN5_V2_WIDTH : EPD_4IN2_V2_WIDTH,
-                   (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) ? EPD_7IN5_V2_HEIGHT : EPD_4IN2_V2_HEIGHT,
-                   0, WHITE);
+    Paint_NewImage(BlackImage, drv->width, drv->height, 0, WHITE);
 
     #ifdef HIGH_VERBOSE_DEBUG
     debug_log("Selecting image...\n");
@@ -1187,58 +1736,105 @@ void format_name_from_email(const char* email, char* outbuf, size_t outbuf_len)
     outbuf[outbuf_len - 1] = '\0';
 }
 
-// Render the default page with room-specific information and QR codes if enabled. This is the page without any user interaction
-void render_page_0(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage) {
+/**
+ * @brief Renders the parts of the default page that do not depend on server data
+ *        (room name, logo, separator lines).
+ *
+ * Called while the Wi-Fi association is still in progress, so the drawing
+ * overlaps with the radio wait. render_page_0_dynamic() adds the seat data later.
+ */
+void render_page_0_static(UBYTE* image_buffer) {
     if (device_config_flash.data.type == ROOM_TYPE_OFFICE && device_config_flash.data.number_of_seats == 3 &&
         device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
 
-    // Display room name & logo
-    Paint_DrawString_EN(40, 50, device_config_flash.data.roomname, &font_ubuntu_mono_28pt_bold,  WHITE, BLACK);
-
-    seat_info_t seat = parse_seat_info(server_response_buf);
-
-    char linebuf[64];
-    if (seat.is_available) {
-        strncpy(linebuf, "frei", sizeof(linebuf));
-    } else {
-        format_name_from_email(seat.user_email, linebuf, sizeof(linebuf));
-    }
-
-    Paint_DrawString_EN(400, 320, linebuf, &font_ubuntu_mono_14pt_bold, WHITE, BLACK);
+        // Display room name & logo
+        Paint_DrawString_EN(40, 50, device_config_flash.data.roomname, &font_ubuntu_mono_28pt_bold,  WHITE, BLACK);
 
-    // Draw a vertical separator line
-    Paint_DrawLine(380, 170, 380, 300, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
+        // Draw a vertical separator line
+        Paint_DrawLine(380, 170, 380, 300, BLACK, DOT_PIXEL_1X1, LINE_STYLE_SOLID);
 
     }
     else if ((device_config_flash.data.type == ROOM_TYPE_CONFERENCE ) &&
         device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
 
         Paint_DrawString_EN(70, 60, device_config_flash.data.roomname, &font_ubuntu_mono_28pt_bold,  WHITE, BLACK);
-          }
+    }
 
     else if ((device_config_flash.data.type == ROOM_TYPE_OFFICE || device_config_flash.data.number_of_seats >= 1) &&
         device_config_flash.data.epapertype == EPAPER_WAVESHARE_4IN2_V2) {
 
         Paint_DrawString_EN(20, 40, device_config_flash.data.roomname, &font_ubuntu_mono_18pt_bold,  WHITE, BLACK);
 
-    if (!draw_flash_logo(image_buffer, 290, 10)) {
-        DrawSubImage(image_buffer, &eSign_100x100_3, 290, 15);
+        if (!draw_flash_logo(image_buffer, 290, 10)) {
+            DrawSubImage(image_buffer, &eSign_100x100_3, 290, 15);
+        }
+    }
+}
+
+/**
+ * @brief Draws "as of HH:MM" if `seat_info` comes from the seat cache.
+ */
+static void draw_seat_info_age(int x, int y) {
+    if (seat_info_as_of == 0) {
+        return;
     }
 
-    seat_info_t seat = parse_seat_info(server_response_buf);
+    ds3231_data_t fetched;
+    char time_str[8];
+    char linebuf[24];
+    rtc_minutes_to_time(seat_info_as_of, &fetched);
+    format_short_time(&fetched, time_str, sizeof(time_str));
+    snprintf(linebuf, sizeof(linebuf), "as of %s", time_str);
+    Paint_DrawString_EN(x, y, linebuf, &font_ubuntu_mono_10pt_bold, WHITE, BLACK);
+}
+
+/**
+ * @brief Renders the server-dependent fields of the default page (seat state, occupant).
+ *
+ * Expects the seat data parsed by wifi_server_communication() in `seat_info` and
+ * the static parts already drawn by render_page_0_static().
+ */
+void render_page_0_dynamic(UBYTE* image_buffer) {
+    if (device_config_flash.data.type == ROOM_TYPE_OFFICE && device_config_flash.data.number_of_seats == 3 &&
+        device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
 
-    // Top line: desk name (e.g. "Desk 3")
-    Paint_DrawString_EN(40, 220, seat.desk_name, &font_ubuntu_mono_14pt, WHITE, BLACK);
+        const seat_info_t seat = seat_info;
 
-    // Second line: status ("frei" or formatted name)
-    char linebuf[64];
-    if (seat.is_available) {
-        strcpy(linebuf, "frei");
-    } else {
-        format_name_from_email(seat.user_email, linebuf, sizeof(linebuf));
+        char linebuf[64];
+        if (seat.is_available) {
+            strncpy(linebuf, "frei", sizeof(linebuf));
+        } else {
+            format_name_from_email(seat.user_email, linebuf, sizeof(linebuf));
+        }
+
+        Paint_DrawString_EN(400, 320, linebuf, &font_ubuntu_mono_14pt_bold, WHITE, BLACK);
+        draw_seat_info_age(400, 370);
     }
-    Paint_DrawString_EN(40, 150, linebuf, &font_ubuntu_mono_14pt_bold, WHITE, BLACK);
+
+    else if ((device_config_flash.data.type == ROOM_TYPE_OFFICE || device_config_flash.data.number_of_seats >= 1) &&
+        device_config_flash.data.epapertype == EPAPER_WAVESHARE_4IN2_V2) {
+
+        const seat_info_t seat = seat_info;
+
+        // Top line: desk name (e.g. "Desk 3")
+        Paint_DrawString_EN(40, 220, seat.desk_name, &font_ubuntu_mono_14pt, WHITE, BLACK);
+
+        // Second line: status ("frei" or formatted name)
+        char linebuf[64];
+        if (seat.is_available) {
+            strcpy(linebuf, "frei");
+        } else {
+            format_name_from_email(seat.user_email, linebuf, sizeof(linebuf));
         }
+        Paint_DrawString_EN(40, 150, linebuf, &font_ubuntu_mono_14pt_bold, WHITE, BLACK);
+        draw_seat_info_age(40, 260);
+    }
+}
+
+// Render the default page with room-specific information and QR codes if enabled. This is the page without any user interaction
+void render_page_0(const wake_context_t* ctx, UBYTE* image_buffer) {
+    render_page_0_static(image_buffer);
+    render_page_0_dynamic(image_buffer);
 }
 
 /**
@@ -1246,9 +1842,9 @@ void render_page_0(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage)
  * This page displays a message and the current time from the RTC.
  *
  * @param room  The room configuration containing ePaper and layout settings.
- * @param clock A pointer to the initialized RTC (ds3231) structure.
+ * @param ctx   Wake context (RTC time, voltages).
  */
-void render_page_1(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage) {
+void render_page_1(const wake_context_t* ctx, UBYTE* image_buffer) {
     char buffer[128]; // Buffer for formatted strings
 
     // Check the ePaper type and render accordingly
@@ -1272,13 +1868,9 @@ void render_page_1(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage)
         sprintf(buffer, "Do Not Disturb!");
         Paint_DrawString_EN(50, 170, buffer, &font_ubuntu_mono_14pt_bold, WHITE, BLACK);
 
-        // Read the current date and time from the RTC
-        ds3231_data_t ds3231_data;
-        ds3231_read_current_time(clock, &ds3231_data);
-
-        // Format and display the current time as "Beginn"
+        // Format and display the wake-up time as "Beginn"
         char time_string[8];
-        format_short_time(&ds3231_data, time_string, sizeof(time_string));
+        format_short_time(&ctx->time, time_string, sizeof(time_string));
         snprintf(buffer, sizeof(buffer), "Start: %s", time_string);
 
         Paint_DrawString_EN(70, 240, buffer, &font_ubuntu_mono_10pt, WHITE, BLACK);
@@ -1300,9 +1892,9 @@ void render_page_1(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage)
 * This page displays a message and a random "Yes" or "No" decision.
 *
 * @param room  The room configuration containing ePaper and layout settings.
-* @param clock A pointer to the initialized RTC (ds3231) structure (not used here but kept for consistency).
+* @param ctx   Wake context (not used here but kept for consistency).
 */
-void render_page_2(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage) {
+void render_page_2(const wake_context_t* ctx, UBYTE* image_buffer) {
     char buffer[128]; // Buffer for formatted strings
     ds3231_data_t ds3231_data;
 
@@ -1384,20 +1976,11 @@ void render_page_2(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage)
  * This page displays device configuration, RTC time, and other key parameters.
  *
  * @param room  The room configuration containing ePaper and layout settings.
- * @param clock A pointer to the initialized RTC (ds3231) structure.
+ * @param ctx   Wake context (RTC time, voltages).
  */
-void render_page_3(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage) {
+void render_page_3(const wake_context_t* ctx, UBYTE* image_buffer) {
     char buffer[256]; // Buffer for formatted strings
-
-    ds3231_data_t ds3231_data;
-
-    // Read the current time from the RTC
-    ds3231_read_current_time(clock, &ds3231_data);
-
-    // Read the current battery voltage
-    // float battery_voltage = read_battery_voltage(device_config_flash.data.conversion_factor);
-    float coin_voltage = read_coin_cell_voltage(device_config_flash.data.conversion_factor);
-
+    const ds3231_data_t* t = &ctx->time; // RTC and voltages from the boot snapshot
 
     // Check the ePaper type and render accordingly
     if (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
@@ -1426,46 +2009,46 @@ void render_page_3(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage)
         sprintf(buffer, "refresh_minutes: [%d,%d,%d,%d,%d,%d,%d,%d]", device_config_flash.data.refresh_minutes_by_pushbutton[0], device_config_flash.data.refresh_minutes_by_pushbutton[1], device_config_flash.data.refresh_minutes_by_pushbutton[2], device_config_flash.data.refresh_minutes_by_pushbutton[3], device_config_flash.data.refresh_minutes_by_pushbutton[4], device_config_flash.data.refresh_minutes_by_pushbutton[5], device_config_flash.data.refresh_minutes_by_pushbutton[6], device_config_flash.data.refresh_minutes_by_pushbutton[7]);
         Paint_DrawString_EN(10, 130, buffer, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
-        // Get current time from RTC
-        ds3231_data_t ds3231_data;
-        ds3231_read_current_time(clock, &ds3231_data);
-
         // Format raw RTC time without DST
         char buffer2[256];
         snprintf(buffer, sizeof(buffer), "%02i:%02i, %s, %02i. %s %04i",
-                 ds3231_data.hours,
-                 ds3231_data.minutes,
-                 get_day_of_week(ds3231_data.day),
-                 ds3231_data.date,
-                 get_month_name(ds3231_data.month),
-                 2000 + ds3231_data.year);
+                 t->hours,
+                 t->minutes,
+                 get_day_of_week(t->day),
+                 t->date,
+                 get_month_name(t->month),
+                 2000 + t->year);
         sprintf(buffer2, "RTC (raw): ");       // Copy the prefix
         strcat(buffer2, buffer);       // Append the original content
 
         Paint_DrawString_EN(10, 150, buffer2, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
-        format_rtc_time(&ds3231_data, buffer, sizeof(buffer));
+        format_rtc_time(t, buffer, sizeof(buffer));
         sprintf(buffer2, "RTC (DST): ");       // Copy the prefix
         strcat(buffer2, buffer);       // Append the original content
         Paint_DrawString_EN(10, 170, buffer2, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
-        read_mac_address();
-        sprintf(buffer, "MAC address: %02X:%02X:%02X:%02X:%02X:%02X",
-                mac_address[0] & 0xFF, mac_address[1] & 0xFF, mac_address[2] & 0xFF,
-                mac_address[3] & 0xFF, mac_address[4] & 0xFF, mac_address[5] & 0xFF);
+        // Recorded at the last association (EEPROM): rendered on core1, often without the radio powered
+        const uint8_t* mac = wake_state.data.mac;
+        if ((mac[0] | mac[1] | mac[2] | mac[3] | mac[4] | mac[5]) == 0) {
+            sprintf(buffer, "MAC address: unknown (no Wi-Fi connection yet)");
+        } else {
+            sprintf(buffer, "MAC address: %02X:%02X:%02X:%02X:%02X:%02X",
+                    mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+        }
         // Draw the MAC address on the ePaper
         Paint_DrawString_EN(10, 190, buffer, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
-        sprintf(buffer, "Vcc: %.3fV", battery_voltage);
+        sprintf(buffer, "Vcc: %.3fV", ctx->battery_voltage);
         Paint_DrawString_EN(10, 210, buffer, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
-        sprintf(buffer, "Vbat: %.3fV", coin_voltage);
+        sprintf(buffer, "Vbat: %.3fV, RTC %.2f C", ctx->coin_cell_voltage, ctx->temperature);
         Paint_DrawString_EN(10, 230, buffer, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
         sprintf(buffer, "adc conv.: %.8f", device_config_flash.data.conversion_factor);
         Paint_DrawString_EN(10, 250, buffer, &font_ubuntu_mono_6pt, WHITE, BLACK);
 
-        display_battery_image(battery_voltage, image_buffer, 330, 190);
+        display_battery_image(ctx->battery_voltage, image_buffer, 330, 190);
         Paint_DrawString_EN(8, 292, "3", &Font8, WHITE, BLACK);
 
     } else {
@@ -1476,7 +2059,7 @@ void render_page_3(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage)
 }
 
 // Howto page
-void render_page_4(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
+void render_page_4(const wake_context_t* ctx, UBYTE* image_buffer){
 
     // Check the ePaper type and render accordingly
     if (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
@@ -1538,7 +2121,7 @@ void render_page_4(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
     }
 }
 
-void render_page_5(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
+void render_page_5(const wake_context_t* ctx, UBYTE* image_buffer){
     const char* page_label = "Page 5: Setting RTC via WIFI to server time";
     int rtc_data_line = -1;
 
@@ -1595,7 +2178,7 @@ void render_page_5(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
     }
 }
 
-void render_page_6(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
+void render_page_6(const wake_context_t* ctx, UBYTE* image_buffer){
 
     // Determine which epaper type is used
     if (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
@@ -1609,7 +2192,7 @@ void render_page_6(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
     }
 }
 
-void render_page_7(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
+void render_page_7(const wake_context_t* ctx, UBYTE* image_buffer){
 
     // Determine which epaper type is used
     if (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
@@ -1627,31 +2210,31 @@ void render_page_7(ds3231_t* clock, UBYTE* image_buffer, float battery_voltage){
 }
 
 // Render the appropriate page based on the RoomConfig and user-selected pushbutton state
-void render_page(int pushbutton, ds3231_t* clock, UBYTE* image_buffer, float battery_voltage) {
+void render_page(int pushbutton, const wake_context_t* ctx, UBYTE* image_buffer) {
     switch (pushbutton) {
         case 0:
-            render_page_0(clock, image_buffer, battery_voltage);  // default page, typial: Display room state or occupation details
+            render_page_0(ctx, image_buffer);  // default page, typial: Display room state or occupation details
             break;
         case 1:
-            render_page_1(clock, image_buffer, battery_voltage);   // typical: Display "Do Not Disturb" message with time
+            render_page_1(ctx, image_buffer);   // typical: Display "Do Not Disturb" message with time
             break;
         case 2:
-            render_page_2(clock, image_buffer, battery_voltage);    // typical: Display a random number generator or utility
+            render_page_2(ctx, image_buffer);    // typical: Display a random number generator or utility
             break;
         case 3:
-            render_page_3(clock, image_buffer, battery_voltage);    // typical: Display current device configuration
+            render_page_3(ctx, image_buffer);    // typical: Display current device configuration
             break;
         case 4:
-            render_page_4(clock, image_buffer, battery_voltage);    // typical: Display current device configuration
+            render_page_4(ctx, image_buffer);    // typical: Display current device configuration
             break;
         case 5:
-            render_page_5(clock, image_buffer, battery_voltage);    // typical: Display current device configuration
+            render_page_5(ctx, image_buffer);    // typical: Display current device configuration
             break;
         case 6:
-            render_page_6(clock, image_buffer, battery_voltage);    // typical: Display current device configuration
+            render_page_6(ctx, image_buffer);    // typical: Display current device configuration
             break;
         case 7:
-            render_page_7(clock, image_buffer, battery_voltage);    // typical: Display current device configuration
+            render_page_7(ctx, image_buffer);    // typical: Display current device configuration
             break;
         default:
             debug_log("Invalid pushbutton state: %d\n", pushbutton);
@@ -1659,6 +2242,34 @@ void render_page(int pushbutton, ds3231_t* clock, UBYTE* image_buffer, float bat
             break;
     }
 }
+/**
+ * @brief Renders the server-independent parts of a page ahead of the Wi-Fi result.
+ *
+ * @param pushbutton Page to render.
+ * @param image_buffer Framebuffer.
+ * @return true if the page is split into static and dynamic parts and the
+ *         static parts were drawn; false if the page has to be rendered
+ *         completely with render_page() once the data has arrived.
+ */
+bool render_page_static(int pushbutton, UBYTE* image_buffer) {
+    if (pushbutton == 0) {
+        render_page_0_static(image_buffer);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Completes a page that was started with render_page_static().
+ */
+void render_page_dynamic(int pushbutton, const wake_context_t* ctx, UBYTE* image_buffer) {
+    if (pushbutton == 0) {
+        render_page_0_dynamic(image_buffer);
+    } else {
+        render_page(pushbutton, ctx, image_buffer);
+    }
+}
+
 /**
  * @brief Displays firmware version and battery status on the ePaper display.
  *
@@ -1696,94 +2307,129 @@ void render_firmware_info(float battery_voltage) {
              program_name, version, build_date, battery_voltage);
 
     // Render the constructed string on the ePaper
-    switch (device_config_flash.data.epapertype) {
-        case EPAPER_WAVESHARE_7IN5_V2:
-            Paint_DrawString_EN(500, 464, buffer, &Font12, WHITE, BLACK);
-            break;
-
-        case EPAPER_WAVESHARE_4IN2_V2:
-            Paint_DrawString_EN(150, 292, buffer, &Font8, WHITE, BLACK);
-            break;
+    const epd_driver_t* drv = epd_driver_current();
+    if (drv == NULL) {
+        debug_log_with_color(COLOR_RED, "Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
+        return;
+    }
+    Paint_DrawString_EN(drv->info_x, drv->info_y, buffer, drv->info_font, WHITE, BLACK);
+}
 
-        case EPAPER_WAVESHARE_2IN9_V2:
-            Paint_DrawString_EN(250, 284, buffer, &Font12, WHITE, BLACK);
-            break;
+/**
+ * @brief Computes the CRC32 fingerprint of the rendered frame and compares it
+ *        with the fingerprint of the frame currently shown on the panel.
+ *
+ * The fingerprint of the last displayed frame is kept in the AT24C32 EEPROM
+ * (see eeprom.h), so it survives the power-off between two wake cycles.
+ *
+ * @param image     Rendered framebuffer.
+ * @param frame_crc Output: fingerprint of `image`, to be stored after a refresh.
+ * @return true if the panel already shows exactly this frame.
+ */
+bool is_frame_unchanged(const UBYTE* image, uint32_t* frame_crc) {
+    *frame_crc = calc_crc32(image, get_epaper_image_size());
 
-        default:
-            debug_log_with_color(COLOR_RED, "Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
-            return;
-    }
+    return wake_state.data.frame_valid &&
+           wake_state.data.epapertype == device_config_flash.data.epapertype &&
+           wake_state.data.frame_crc == *frame_crc;
 }
 
-void epaper_finalize_and_powerdown(UBYTE* image) {
-    if (image == NULL) {
-        debug_log("No valid image buffer to display. Skipping ePaper operations.\n");
-        return;
+/**
+ * @brief Sends the frame with the waveform picked by the refresh plan and waits for the refresh.
+ *
+ * @param image Framebuffer to display.
+ * @param plan Refresh plan from epaper_plan_refresh().
+ * @return true on success, false for unsupported panel types or a BUSY timeout.
+ */
+static bool epaper_display_frame(UBYTE* image, const epaper_refresh_plan_t* plan) {
+    const epd_driver_t* drv = epd_driver_current();
+    if (drv == NULL) {
+        debug_log_with_color(COLOR_RED, "Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
+        return false;
     }
 
-    watchdog_update();
-
-    // Display the final image based on the configured ePaper type
     #ifdef HIGH_VERBOSE_DEBUG
-    debug_log("EPD_Display called for epaper type: %d\n", device_config_flash.data.epapertype);
+    debug_log("Display called for %s\n", drv->name);
     #endif
 
-    switch (device_config_flash.data.epapertype) {
-        case EPAPER_WAVESHARE_7IN5_V2:
-            EPD_7IN5_V2_Display(image);
-            break;
-
-        case EPAPER_WAVESHARE_4IN2_V2:
-            EPD_4IN2_V2_Display(image);
-            break;
-
-        case EPAPER_WAVESHARE_2IN9_V2:
-            EPD_2IN9_V2_Display(image);
-            break;
-
-        default:
-            debug_log_with_color(COLOR_RED, "Unsupported ePaper type: %d\n", device_config_flash.data.epapertype);
-            free(image);
-            return;
+    bool refreshed;
+    if (plan->mode == EPAPER_REFRESH_PARTIAL && drv->partial != NULL) {
+        debug_log("Partial refresh of %d window(s)\n", plan->damage.count);
+        refreshed = drv->partial((const UBYTE*)FLASH_PTR(FRAME_FLASH_OFFSET), image, &plan->damage);
+    } else if (plan->mode == EPAPER_REFRESH_FAST && drv->display_fast != NULL) {
+        refreshed = drv->display_fast(image);
+    } else {
+        refreshed = drv->display(image);
     }
 
-    // Free allocated memory for the image
-    free(image);
-    image = NULL;
-    watchdog_update();
+    if (!refreshed) {
+        debug_log_with_color(COLOR_RED, "ePaper BUSY timeout, %s refresh not completed\n", epaper_refresh_mode_name(plan->mode));
+    }
+    return refreshed;
+}
 
-    // Put the e-Paper display into sleep mode based on the type
-    #ifdef HIGH_VERBOSE_DEBUG
-    debug_log("Entering ePaper sleep mode for type: %d\n", device_config_flash.data.epapertype);
-    #endif
+/**
+ * @brief Pushes the frame to the panel with the waveform chosen by the refresh
+ *        policy, then puts the panel to sleep and powers the interface down.
+ *
+ * The framebuffer stays owned by the caller, so it can still be stored as
+ * base frame (epaper_store_base_frame()) before it is freed.
+ *
+ * On a failed refresh (e.g. BUSY timeout) the panel is put to sleep as well,
+ * but the refresh bookkeeping (base frame, deghosting counter) is left alone.
+ *
+ * @param image Rendered framebuffer.
+ * @return true if the frame was displayed.
+ */
+bool epaper_finalize_and_powerdown(UBYTE* image) {
+    if (image == NULL) {
+        debug_log("No valid image buffer to display. Skipping ePaper operations.\n");
+        return false;
+    }
 
-    switch (device_config_flash.data.epapertype) {
-        case EPAPER_WAVESHARE_7IN5_V2:
-            EPD_7IN5_V2_Sleep();
-            break;
+    epaper_refresh_plan_t plan;
+    epaper_plan_refresh(image, &plan);
+    debug_log("ePaper refresh mode: %s%s\n", epaper_refresh_mode_name(plan.mode),
+              plan.clear_first ? " (with deghosting clear)" : "");
 
-        case EPAPER_WAVESHARE_4IN2_V2:
-            EPD_4IN2_V2_Sleep();
-            break;
+    if (!init_epaper_panel(&plan)) {
+        epaper_sleep_panel();
+        return false;
+    }
 
-        case EPAPER_WAVESHARE_2IN9_V2:
-            EPD_2IN9_V2_Sleep();
-            break;
+    watchdog_update(); // The frame planes stream by DMA, the core sleeps at the wait level meanwhile
 
-        default:
-            debug_log_with_color(COLOR_RED, "Unsupported ePaper type during sleep: %d\n", device_config_flash.data.epapertype);
-            return;
+    uint32_t busy_before_ms = DEV_Busy_Time_ms();
+    if (!epaper_display_frame(image, &plan)) {
+        epaper_sleep_panel();
+        return false;
     }
 
-    // Short delay to ensure the sleep command is processed
-    DEV_Delay_ms(200);
+    // The panel is write-only (no MISO), so the refresh itself is the bus check
+    uint32_t busy_ms = DEV_Busy_Time_ms() - busy_before_ms;
+    if (busy_ms < EPAPER_MIN_REFRESH_BUSY_MS && DEV_SPI_Get_Baudrate() > DEV_SPI_DEFAULT_HZ) {
+        debug_log_with_color(COLOR_RED, "Panel did not refresh at %lu kHz (BUSY %lu ms), retrying at %lu kHz\n",
+                             (unsigned long)(DEV_SPI_Get_Baudrate() / 1000), (unsigned long)busy_ms,
+                             (unsigned long)(DEV_SPI_DEFAULT_HZ / 1000));
+        wake_state.data.spi_fallback_khz = (uint16_t)(epaper_spi_hz() / 1000u); // Saved at power-down
+        DEV_SPI_Set_Baudrate(DEV_SPI_DEFAULT_HZ); // Bus is up: takes effect immediately
+
+        // Same waveform again; the deghosting clear is not repeated (another full-screen flash)
+        epaper_refresh_plan_t retry = plan;
+        retry.clear_first = false;
+        epaper_panel_ready = false; // Reset and re-init the controller
+        if (!init_epaper_panel(&retry) || !epaper_display_frame(image, &retry)) {
+            epaper_sleep_panel();
+            return false;
+        }
+    }
 
-    // Proceed with complete power-off sequence
-    #ifdef HIGH_VERBOSE_DEBUG
-    debug_log("Shutting down the ePaper module...\n");
-    #endif
-    DEV_Module_Exit();
+    epaper_pixels_shown_ms = to_ms_since_boot(get_absolute_time()); // BUSY released: the new frame is visible
+    epaper_refresh_done(&plan);
+    wake_metrics_set_refresh(plan.mode);
     watchdog_update();
+
+    return epaper_sleep_panel();
 }
 
 /**
@@ -1842,15 +2488,12 @@ bool is_wifi_required(int pushbutton) {
  * time from the RTC and additional diagnostic information.
  *
  * @param room Pointer to the RoomConfig structure for ePaper configuration.
- * @param clock Pointer to the ds3231_t structure for accessing RTC data.
+ * @param ctx Wake context (RTC time of the wake-up).
  * @param image_buffer Image buffer used for subimage rendering.
  */
-void render_page_server_error(ds3231_t* clock, UBYTE* image_buffer) {
+void render_page_server_error(const wake_context_t* ctx, UBYTE* image_buffer) {
     char buffer[256]; // Buffer for formatted strings
-    ds3231_data_t ds3231_data;
-
-    // Read the current time from the RTC
-    ds3231_read_current_time(clock, &ds3231_data);
+    ds3231_data_t ds3231_data = ctx->time; // Wake-up time from the boot snapshot
 
     // Clear the ePaper display
     Paint_Clear(WHITE);
@@ -1912,14 +2555,11 @@ void render_page_server_error(ds3231_t* clock, UBYTE* image_buffer) {
  * diagnostic information.
  *
  * @param room Pointer to the RoomConfig structure for ePaper configuration.
- * @param clock Pointer to the ds3231_t structure for accessing RTC data.
+ * @param ctx Wake context (RTC time of the wake-up).
  */
-void render_page_wifi_error(ds3231_t* clock, UBYTE* image_buffer) {
+void render_page_wifi_error(const wake_context_t* ctx, UBYTE* image_buffer) {
     char buffer[256]; // Buffer for formatted strings
-    ds3231_data_t ds3231_data;
-
-    // Read the current time from the RTC
-    ds3231_read_current_time(clock, &ds3231_data);
+    ds3231_data_t ds3231_data = ctx->time; // Wake-up time from the boot snapshot
 
     // Clear the ePaper display
     Paint_Clear(WHITE);
@@ -1966,6 +2606,54 @@ void render_page_wifi_error(ds3231_t* clock, UBYTE* image_buffer) {
     debug_log_with_color(COLOR_RED, "Wi-Fi error page rendered.\n");
 }
 
+/**
+ * @brief Renders the final "replace batteries" page.
+ *
+ * Shown once the battery voltage falls below `switch_off_battery_voltage`;
+ * afterwards no RTC wake-ups are scheduled. The page contains no time or
+ * voltage, so later button presses find the frame unchanged and skip the refresh.
+ *
+ * @param image_buffer Image buffer used for subimage rendering.
+ */
+void render_page_battery_empty(UBYTE* image_buffer) {
+    char buffer[64];
+
+    Paint_Clear(WHITE);
+    const char* battery_msg = "Please replace the batteries";
+    snprintf(buffer, sizeof(buffer), "Switched off below %.2f V", device_config_flash.data.switch_off_battery_voltage);
+
+    if (device_config_flash.data.epapertype == EPAPER_WAVESHARE_7IN5_V2) {
+
+        // Display the default logo
+        DrawSubImage(image_buffer, &eSign_128x128_white_background3, 270, 5);
+
+        // Display the room name
+        Paint_DrawString_EN(70, 60, device_config_flash.data.roomname, &font_ubuntu_mono_28pt_bold, WHITE, BLACK);
+
+        DrawSubImage(image_buffer, &battery_levels_64x97[BATTERY_LEVEL_1], 50, 180);
+        Paint_DrawString_EN(140, 200, "Battery empty!", &font_ubuntu_mono_22pt_bold, WHITE, BLACK);
+        Paint_DrawString_EN(50, 300, battery_msg, &font_ubuntu_mono_16pt, WHITE, BLACK);
+        Paint_DrawString_EN(50, 370, buffer, &font_ubuntu_mono_12pt, WHITE, BLACK);
+
+    } else if (device_config_flash.data.epapertype == EPAPER_WAVESHARE_4IN2_V2) {
+
+        // Display room name & logo
+        Paint_DrawString_EN(20, 40, device_config_flash.data.roomname, &font_ubuntu_mono_18pt_bold,  WHITE, BLACK);
+        if (!draw_flash_logo(image_buffer, 285, 10)) {
+            DrawSubImage(image_buffer, &eSign_100x100_3, 280, 15);
+        }
+
+        Paint_DrawString_EN(20, 120, "Battery empty!", &font_ubuntu_mono_12pt_bold, WHITE, BLACK);
+        Paint_DrawString_EN(20, 180, battery_msg, &font_ubuntu_mono_8pt, WHITE, BLACK);
+        Paint_DrawString_EN(20, 260, buffer, &font_ubuntu_mono_8pt, WHITE, BLACK);
+
+    } else {
+        debug_log_with_color(COLOR_RED, "Unsupported ePaper type in render_page_battery_empty: %d\n", device_config_flash.data.epapertype);
+    }
+
+    debug_log_with_color(COLOR_RED, "Battery empty page rendered.\n");
+}
+
 void render_page_wifi_setup(UBYTE* image) {
     if (!draw_flash_logo(image, 290, 10)) {
         DrawSubImage(image, &eSign_100x100_3, 290, 15);
@@ -2127,8 +2815,10 @@ void enter_wifi_setup_mode(ds3231_t* clock) {
 
     UBYTE* BlackImage = init_epaper();
     if (BlackImage != NULL) {
+        invalidate_frame_fingerprint(clock); // Panel no longer shows the regular page
         render_page_wifi_setup(BlackImage);
         epaper_finalize_and_powerdown(BlackImage);
+        free(BlackImage);
     }
 
     debug_log_with_color(COLOR_GREEN, "WiFi setup mode: initializing...\n");
@@ -2240,40 +2930,222 @@ bool wait_for_usb_connection(uint32_t timeout_ms) {
     return true;  // Verbunden
 }
 
+//  ---------------------dual-core wake cycle--------------------------------
+/*
+ * Core0 keeps cyw43/lwIP running (association, HTTP request), core1 renders the
+ * page and pushes the frame over SPI. The cores only talk through the SIO FIFO:
+ *
+ *   core0 -> core1: WifiResult, once the server data is parsed (`seat_info`)
+ *   core1 -> core0: RENDER_CORE_FRAME_*, once the frame is committed or skipped
+ *
+ * Flash writes (base frame) and the EEPROM wake state stay on core0 and are
+ * only done after core1 has reported back.
+ */
+#define RENDER_CORE_FRAME_COMMITTED  0x52430001  // Frame displayed, panel asleep
+#define RENDER_CORE_FRAME_UNCHANGED  0x52430002  // Panel already shows this frame
+#define RENDER_CORE_FRAME_FAILED     0x52430003  // Panel could not be refreshed
+
+typedef struct {
+    int pushbutton;
+    bool wifi_required;
+    bool battery_empty;    // Shutdown power tier: render the "replace batteries" page
+    WifiResult error_shown; // Error page currently on the panel (WIFI_SUCCESS = none)
+    bool outage;           // Previous wake failed: no speculative panel bring-up
+    bool from_cache;       // Set by core0: update failed, `seat_info` holds the cached data
+    bool cache_on_panel;   // Set by core0: the panel already shows the page of the cached data
+    bool interactive;      // Button page without server data: drawn before the hand-over, core0 prepares the panel
+    const wake_context_t* context; // Boot snapshot of RTC time, temperature and voltages
+    UBYTE* image;
+    uint32_t frame_crc;    // Set by core1: fingerprint of the rendered page
+} render_job_t;
+
+static render_job_t render_job;
+
+/**
+ * @brief Renders the page for the WifiResult and commits it to the panel (core1).
+ *
+ * @return RENDER_CORE_FRAME_* status for core0.
+ */
+static uint32_t render_core_render_and_display(render_job_t* job, WifiResult wifi_result, bool static_rendered,
+                                               bool page_rendered) {
+    debug_log_with_color(COLOR_GREEN, "render_page (core1)\n");
+    wake_metrics_begin(WAKE_PHASE_RENDER);
+    // Handle Wi-Fi and server errors with specific pages
+    if (job->battery_empty) {
+        render_page_battery_empty(job->image);
+    } else if (wifi_result == WIFI_ERROR_CONNECTION) {
+        render_page_wifi_error(job->context, job->image); // Display Wi-Fi error page
+    } else if (wifi_result == WIFI_ERROR_SERVER) {
+        render_page_server_error(job->context, job->image); // Display server error page
+    } else if (static_rendered) {
+        render_page_dynamic(job->pushbutton, job->context, job->image); // Fill in the server data
+    } else if (!page_rendered) { // Button pages are drawn before the FIFO hand-over
+        render_page(job->pushbutton, job->context, job->image); // Render normal page
+    }
+
+    // The fingerprint is taken before the firmware info line, whose voltage
+    // reading jitters between wakes and would defeat the comparison
+    uint32_t status;
+    bool unchanged = is_frame_unchanged(job->image, &job->frame_crc);
+    wake_metrics_end(WAKE_PHASE_RENDER);
+
+    wake_metrics_begin(WAKE_PHASE_DISPLAY);
+    if (unchanged) {
+        debug_log_with_color(COLOR_GREEN, "Frame unchanged (CRC 0x%08lx), skipping ePaper refresh\n", (unsigned long)job->frame_crc);
+        epaper_sleep_panel(); // Panel may have been prepared during the Wi-Fi association
+        status = RENDER_CORE_FRAME_UNCHANGED;
+    } else {
+        if (job->pushbutton != 4) {
+            render_firmware_info(job->context->battery_voltage);
+        }
+
+        debug_log_with_color(COLOR_GREEN, "epaper_finalize_and_powerdown (display epaper page)...\n");
+        status = epaper_finalize_and_powerdown(job->image) ? RENDER_CORE_FRAME_COMMITTED : RENDER_CORE_FRAME_FAILED;
+        debug_log("Panel BUSY for %lu ms (core1 asleep), frame data %lu us over %s at %lu kHz (%s)\n",
+                  (unsigned long)DEV_Busy_Time_ms(), (unsigned long)DEV_SPI_Time_us(),
+                  DEV_SPI_PIO ? "pio" : "spi1", (unsigned long)(DEV_SPI_Get_Baudrate() / 1000),
+                  DEV_SPI_BURST ? "burst" : "byte-wise");
+    }
+    wake_metrics_end(WAKE_PHASE_DISPLAY);
+
+    return status;
+}
+
+/**
+ * @brief Core1 entry: renders the page and streams it to the panel.
+ *
+ * Static page parts and the speculative panel bring-up run while core0 is
+ * still waiting for the network; the dynamic parts follow as soon as core0
+ * delivers the WifiResult through the FIFO.
+ */
+static void render_core_entry(void) {
+    render_job_t* job = &render_job;
+    bool static_rendered = false;
+    bool page_rendered = false;
+
+    clock_policy_run();
+    if (job->wifi_required) {
+        wake_metrics_begin(WAKE_PHASE_RENDER);
+        static_rendered = render_page_static(job->pushbutton, job->image);
+        wake_metrics_end(WAKE_PHASE_RENDER);
+
+        // Not during an outage: the same error page or cached page again would not need the panel
+        if (job->error_shown == WIFI_SUCCESS && !job->outage) {
+            wake_metrics_begin(WAKE_PHASE_EPAPER_INIT);
+            epaper_prepare_panel(false);
+            wake_metrics_end(WAKE_PHASE_EPAPER_INIT);
+        }
+    } else if (job->interactive) {
+        wake_metrics_begin(WAKE_PHASE_RENDER);
+        render_page(job->pushbutton, job->context, job->image);
+        wake_metrics_end(WAKE_PHASE_RENDER);
+        page_rendered = true;
+    }
+
+    clock_policy_wait();
+    WifiResult wifi_result = (WifiResult)multicore_fifo_pop_blocking();
+    __dmb(); // seat_info was written by core0 before the push
+    clock_policy_run();
+
+    uint32_t status;
+    if (job->from_cache && job->cache_on_panel) {
+        debug_log_with_color(COLOR_YELLOW, "Panel already shows the cached data, skipping ePaper refresh\n");
+        epaper_sleep_panel();
+        status = RENDER_CORE_FRAME_UNCHANGED;
+    } else if (wifi_result != WIFI_SUCCESS && wifi_result == job->error_shown) {
+        // Same error as on the panel: keep the screen (and the time of the first failure)
+        debug_log_with_color(COLOR_YELLOW, "Error page %d already shown, skipping ePaper refresh\n", wifi_result);
+        epaper_sleep_panel();
+        status = RENDER_CORE_FRAME_UNCHANGED;
+    } else {
+        status = render_core_render_and_display(job, wifi_result, static_rendered, page_rendered);
+    }
+
+    __dmb();
+    multicore_fifo_push_blocking(status);
+
+    while (true) {
+        __wfe();
+    }
+}
+
 int main(void)
 {
     // Set debug mode (real-time, buffered, or both)
-    // set_debug_mode(DEBUG_BUFFERED);
-    set_debug_mode(DEBUG_REALTIME);
+    // Buffered until it is known whether USB stdio is started right away (see the press-to-pixels path)
+    set_debug_mode(DEBUG_BUFFERED);
 
     debug_log_with_color(COLOR_GREEN, "hold power\n");
     hold_power();  // Hold power state of the circuit
+    wake_metrics_end(WAKE_PHASE_HOLD_POWER); // Phase started at boot (time 0)
 
-    stdio_init_all();     // Initialize standard I/O
-/*
-    if (wait_for_usb_connection(2500)) { // only used for debugging
-        printf("USB connected\n");
-    } else {
-        printf("USB timeout\n");
-    }*/
+    clock_policy_init();  // clk_peri to pll_usb before stdio, SPI and I2C are set up
+
+    debug_log_with_color(COLOR_GREEN, "start setup_and_read_pushbuttons\n");
+    setup_and_read_pushbuttons();     // Initialize pushbuttons and read their state
+
+    // pushbutton = 7; // use for debugging
 
     debug_log_with_color(COLOR_BOLD_GREEN, "System initializing\n");
 
-    print_firmware_slots_status();
+    // Older or erased device config to the current layout (flash.c), before core1 or the watchdog run
+    migrate_device_config();
 
     debug_log_with_color(COLOR_GREEN, "watchdog_enable\n");
     watchdog_enable(device_config_flash.data.watchdog_time, 0);
 
+    // Sensor snapshot for the whole wake (wake_context.h); the coin-cell divider settles during the RTC init
     debug_log_with_color(COLOR_GREEN, "ADC read\n");
-    float battery_voltage = read_battery_voltage(device_config_flash.data.conversion_factor);
+    wake_metrics_begin(WAKE_PHASE_ADC);
+    wake_context_begin(&wake_context, device_config_flash.data.conversion_factor);
+    wake_metrics_end(WAKE_PHASE_ADC);
+    float battery_voltage = wake_context.battery_voltage;
 
     debug_log_with_color(COLOR_GREEN, "init real time clock DS3231\n");
+    wake_metrics_begin(WAKE_PHASE_RTC_INIT);
     ds3231 = init_clock(); // Initialize clock
-    debug_log_with_color(COLOR_GREEN, "start setup_and_read_pushbuttons\n");
+    wake_context_read_rtc(&wake_context, &ds3231);
+    load_wake_state(&ds3231); // Persistent state of the previous wake cycle (EEPROM)
+    load_wifi_cache(&ds3231); // Last access point and DHCP lease for the fast reconnect
+    load_seat_cache(&ds3231); // Server data of the last scheduled wake
+    time_sync_init(&ds3231); // Aging offset as programmed in the DS3231
+    wake_metrics_end(WAKE_PHASE_RTC_INIT);
 
-    setup_and_read_pushbuttons();     // Initialize pushbuttons and read their state
+    wake_metrics_begin(WAKE_PHASE_ADC);
+    wake_context_finish(&wake_context, device_config_flash.data.conversion_factor);
+    wake_metrics_end(WAKE_PHASE_ADC);
 
-    // pushbutton = 7; // use for debugging
+    power_governor_init(battery_voltage); // Power tier from the battery voltage (needs the wake state)
+
+    WifiResult wifi_result = WIFI_NOT_REQUIRED;
+    uint32_t wake_minutes = wake_context.rtc_minutes;
+    bool battery_empty = (power_governor_tier() == POWER_TIER_SHUTDOWN);
+    bool wifi_required = !battery_empty && is_wifi_required(pushbutton);
+
+    // Button pages use the seat data the last scheduled wake fetched, no second radio session
+    if (wifi_required && seat_cache_fresh(pushbutton, wake_minutes)) {
+        debug_log_with_color(COLOR_GREEN, "Page %d renders from the seat data cached at minute %lu, radio stays off\n",
+                             pushbutton, (unsigned long)seat_cache.data.fetched_at);
+        seat_cache_restore(wake_minutes);
+        wifi_required = false;
+    }
+
+    // Press-to-pixels fast path: a button page without a radio session has someone waiting at the
+    // door, USB stdio, the slot listing and the console output wait until the frame is shown
+    bool interactive = (pushbutton != 0 && pushbutton != 7 && !battery_empty && !wifi_required);
+    epaper_refresh_set_interactive(interactive);
+    if (!interactive) {
+        stdio_init_all();     // Initialize standard I/O
+        transmit_debug_logs();
+        set_debug_mode(DEBUG_REALTIME);
+        print_firmware_slots_status();
+    }
+/*
+    if (wait_for_usb_connection(2500)) { // only used for debugging
+        printf("USB connected\n");
+    } else {
+        printf("USB timeout\n");
+    }*/
 
     // Enter WiFi setup mode if all three buttons are held
     if (pushbutton == 7) {
@@ -2282,35 +3154,105 @@ int main(void)
      //   return 0;  // The device will shut down inside setup mode (after timeout or user action)
     }
 
-    debug_log_with_color(COLOR_GREEN, "wifi_server_communication\n");
-    WifiResult wifi_result = WIFI_NOT_REQUIRED;
-
-    if (is_wifi_required(pushbutton)) {
-        wifi_result = wifi_server_communication(battery_voltage);
+    // Start the association first, panel bring-up and static rendering run while it completes
+    if (wifi_required) {
+        wake_metrics_load_pending(&ds3231); // EEPROM access before core1 uses the I2C bus
+        debug_log_with_color(COLOR_GREEN, "wifi_connect_start\n");
+        wake_metrics_begin(WAKE_PHASE_WIFI_INIT);
+        wifi_connect_start();
+        wake_metrics_end(WAKE_PHASE_WIFI_INIT);
     }
 
+    wake_metrics_begin(WAKE_PHASE_EPAPER_INIT);
     UBYTE* BlackImage = init_epaper();
+    wake_metrics_end(WAKE_PHASE_EPAPER_INIT);
     if (BlackImage == NULL) {
         debug_log_with_color(COLOR_RED, "BlackImage buffer memory allocation failed.\n");
         return -1;
     }
 
-    debug_log_with_color(COLOR_GREEN, "render_page\n");
-    // Handle Wi-Fi and server errors with specific pages
-    if (wifi_result == WIFI_ERROR_CONNECTION) {
-        render_page_wifi_error(&ds3231, BlackImage); // Display Wi-Fi error page
-    } else if (wifi_result == WIFI_ERROR_SERVER) {
-        render_page_server_error(&ds3231,BlackImage); // Display server error page
-    } else {
-        render_page(pushbutton, &ds3231, BlackImage, battery_voltage); // Render normal page
-    }
-
-    if (pushbutton != 4) {
-        render_firmware_info(battery_voltage);
-    }
+    // Rendering and the SPI frame push run on core1, core0 stays with the network
+    render_job.pushbutton = pushbutton;
+    render_job.wifi_required = wifi_required;
+    render_job.battery_empty = battery_empty;
+    render_job.error_shown = wake_state.data.frame_valid ? (WifiResult)wake_state.data.error_shown : WIFI_SUCCESS;
+    render_job.outage = (wake_state.data.failure_streak > 0);
+    render_job.interactive = interactive;
+    render_job.context = &wake_context;
+    render_job.image = BlackImage;
+    multicore_launch_core1(render_core_entry);
 
-    debug_log_with_color(COLOR_GREEN, "epaper_finalize_and_powerdown (display epaper page)...\n");
-    epaper_finalize_and_powerdown(BlackImage);
+    if (wifi_required) {
+        debug_log_with_color(COLOR_GREEN, "wifi_server_communication\n");
+        wifi_result = wifi_server_communication(battery_voltage);
+    } else if (interactive) {
+        // Panel reset and fast waveform while core1 draws the page
+        wake_metrics_begin(WAKE_PHASE_EPAPER_INIT);
+        epaper_prepare_panel(epaper_panel_supports_fast());
+        wake_metrics_end(WAKE_PHASE_EPAPER_INIT);
+    }
+
+    // Stale-while-revalidate: after a failed update core1 renders the last good data instead of an error page
+    WifiResult render_result = wifi_result;
+    if (wifi_result == WIFI_SUCCESS) {
+        seat_cache_update(wifi_start_minutes);
+    } else if ((wifi_result == WIFI_ERROR_CONNECTION || wifi_result == WIFI_ERROR_SERVER) &&
+               seat_cache_restore(wake_minutes)) {
+        render_job.from_cache = true;
+        render_job.cache_on_panel = pushbutton == 0 && wake_state.data.frame_valid &&
+                                    wake_state.data.frame_crc == seat_cache.data.frame_crc;
+        render_result = WIFI_SUCCESS;
+        debug_log_with_color(COLOR_YELLOW, "Update failed (%d), showing seat data cached at minute %lu\n",
+                             wifi_result, (unsigned long)seat_cache.data.fetched_at);
+    }
+
+    __dmb();
+    multicore_fifo_push_blocking((uint32_t)render_result);
+
+    // Core1 never touches I2C: the RTC check overlaps the frame push and the panel refresh
+    time_sync_apply(&ds3231); // Before the alarm is set from the clock
+
+    clock_policy_wait();
+    uint32_t render_status = multicore_fifo_pop_blocking();
+    __dmb();
+    multicore_reset_core1();
+    clock_policy_release_core(1);
+
+    if (interactive) {
+        stdio_init_all();     // Deferred until the frame is on the panel
+        set_debug_mode(DEBUG_BOTH);
+        print_firmware_slots_status();
+    }
+    if (epaper_pixels_shown_ms > 0) {
+        debug_log_with_color(COLOR_BOLD_GREEN, "Press-to-pixels: %lu ms after power-on (%s wake)\n",
+                             (unsigned long)epaper_pixels_shown_ms, interactive ? "button" : "scheduled");
+    }
+    clock_policy_run(); // Base frame CRC and flash write
+
+    wake_metrics_begin(WAKE_PHASE_POWER_DOWN);
+
+    if (render_status == RENDER_CORE_FRAME_COMMITTED) {
+        epaper_store_base_frame(BlackImage);
+        wake_state.data.epapertype = device_config_flash.data.epapertype;
+        wake_state.data.frame_crc = render_job.frame_crc;
+        wake_state.data.frame_valid = 1;
+        wake_state.data.error_shown = (render_result == WIFI_ERROR_CONNECTION || render_result == WIFI_ERROR_SERVER)
+                                      ? render_result : WIFI_SUCCESS;
+    }
+    if (wifi_result == WIFI_SUCCESS && pushbutton == 0 && render_status != RENDER_CORE_FRAME_FAILED) {
+        seat_cache.data.frame_crc = render_job.frame_crc; // Lets a later failure skip the refresh
+    }
+    wake_scheduler_record_result(wifi_result); // Failure streak for the retry backoff
+    free(BlackImage);
+    wake_metrics_end(WAKE_PHASE_POWER_DOWN);
+
+    debug_log("Clock: %lu ms at run level, %lu ms at wait level\n",
+              (unsigned long)clock_policy_time_ms(CLOCK_LEVEL_RUN),
+              (unsigned long)clock_policy_time_ms(CLOCK_LEVEL_WAIT));
+    wake_metrics_write(&ds3231, wake_minutes, battery_voltage, pushbutton, wifi_result);
+    save_wake_state(&ds3231);
+    save_wifi_cache(&ds3231);
+    save_seat_cache(&ds3231);
 
     // Transmit logs before shutdown
     debug_log_with_color(COLOR_BOLD_GREEN, "...System shutting down.  \n");
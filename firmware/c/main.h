@@ -10,16 +10,23 @@ extern ds3231_t rtc;
 
 void set_rtc_from_display_string(ds3231_t* ds3231, const char* line);
 void set_alarmclock_and_powerdown(ds3231_t* clock);
-void epaper_finalize_and_powerdown(UBYTE* image);
+bool epaper_finalize_and_powerdown(UBYTE* image);
 void read_mac_address();
 float read_battery_voltage(float conversion_factor);
 float read_coin_cell_voltage(float conversion_factor);
 void format_rtc_time(const ds3231_data_t* t, char* buffer, size_t buffer_size);
+uint32_t rtc_minutes_since_2000(const ds3231_data_t* t);
+void rtc_minutes_to_time(uint32_t minutes, ds3231_data_t* t);
+bool is_dst_europe(const ds3231_data_t* t);
 const char* get_day_of_week(int day);
 const char* get_month_name(int month);
 
 
 UBYTE* init_epaper();
+UWORD get_epaper_image_size(void);
+bool epaper_prepare_panel(bool fast);
+bool epaper_sleep_panel(void);
+bool wifi_connect_start(void);
 
 
 #endif
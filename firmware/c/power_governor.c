@@ -0,0 +1,144 @@
+/**
+ * @file power_governor.c
+ * @brief Battery-voltage driven power tiers.
+ */
+
+#include "power_governor.h"
+#include "flash.h"
+#include "eeprom.h"
+#include "debug.h"
+
+/**
+ * @brief Budget of a tier. A limit of 0 keeps the configured value.
+ */
+typedef struct {
+    const char* name;
+    int interval_factor;       ///< Multiplier for wake intervals and full/deghost refresh counts
+    int max_wifi_attempts;
+    int max_wifi_timeout_ms;   ///< Per association attempt
+    int max_http_wait_ms;      ///< Server response deadline
+} power_tier_limits_t;
+
+static const power_tier_limits_t tier_limits[POWER_TIER_COUNT] = {
+    [POWER_TIER_NORMAL]   = {"normal",   1, 0, 0,    0},
+    [POWER_TIER_SAVING]   = {"saving",   2, 3, 5000, 5000},
+    [POWER_TIER_CRITICAL] = {"critical", 4, 1, 3000, 3000},
+    [POWER_TIER_SHUTDOWN] = {"shutdown", 4, 1, 3000, 3000},
+};
+
+static power_tier_t current_tier = POWER_TIER_NORMAL;
+
+/**
+ * @brief Voltage below which a tier is entered (NORMAL: none).
+ */
+static float tier_threshold(power_tier_t tier) {
+    const device_config_data_t* cfg = &device_config_flash.data;
+
+    switch (tier) {
+        case POWER_TIER_SAVING:   return cfg->power_saving_voltage;
+        case POWER_TIER_CRITICAL: return cfg->power_critical_voltage;
+        case POWER_TIER_SHUTDOWN: return cfg->switch_off_battery_voltage;
+        default:                  return 0.0f;
+    }
+}
+
+/**
+ * @brief Selects the tier for this wake.
+ *
+ * The lowest tier whose threshold is above the voltage wins. Leaving a tier
+ * towards a better one needs POWER_GOVERNOR_HYSTERESIS of headroom, so the
+ * recovery of the cells between wakes does not make the tier oscillate. The
+ * tier is kept in the wake state; call after load_wake_state().
+ *
+ * @param battery_voltage Battery voltage measured at boot.
+ */
+void power_governor_init(float battery_voltage) {
+    power_tier_t previous = (power_tier_t)wake_state.data.power_tier;
+    power_tier_t tier = POWER_TIER_NORMAL;
+
+    if (previous >= POWER_TIER_COUNT) {
+        previous = POWER_TIER_NORMAL;
+    }
+
+    for (int t = POWER_TIER_SAVING; t < POWER_TIER_COUNT; t++) {
+        float threshold = tier_threshold((power_tier_t)t);
+        if (threshold <= 0.0f) {
+            continue; // Tier disabled
+        }
+        if (t <= previous) {
+            threshold += POWER_GOVERNOR_HYSTERESIS;
+        }
+        if (battery_voltage < threshold) {
+            tier = (power_tier_t)t;
+        }
+    }
+
+    if (tier != previous) {
+        debug_log_with_color(tier > previous ? COLOR_YELLOW : COLOR_GREEN,
+                             "Power tier %s -> %s (%.3f V)\n",
+                             power_tier_name(previous), power_tier_name(tier), battery_voltage);
+    }
+
+    current_tier = tier;
+    wake_state.data.power_tier = (uint8_t)tier;
+}
+
+/**
+ * @brief Returns the tier selected by power_governor_init().
+ */
+power_tier_t power_governor_tier(void) {
+    return current_tier;
+}
+
+/**
+ * @brief Returns a short name of the tier for logging and the status page.
+ */
+const char* power_tier_name(power_tier_t tier) {
+    return (tier < POWER_TIER_COUNT) ? tier_limits[tier].name : "unknown";
+}
+
+static int cap(int configured, int limit) {
+    return (limit > 0 && configured > limit) ? limit : configured;
+}
+
+/**
+ * @brief Stretches a wake interval (minutes) according to the tier.
+ */
+int power_governor_refresh_minutes(int minutes) {
+    return minutes * tier_limits[current_tier].interval_factor;
+}
+
+/**
+ * @brief Caps the number of Wi-Fi association attempts.
+ */
+int power_governor_wifi_attempts(int configured) {
+    return cap(configured, tier_limits[current_tier].max_wifi_attempts);
+}
+
+/**
+ * @brief Caps the timeout of one Wi-Fi association attempt (ms).
+ */
+int power_governor_wifi_timeout_ms(int configured) {
+    return cap(configured, tier_limits[current_tier].max_wifi_timeout_ms);
+}
+
+/**
+ * @brief Caps the deadline for the server response (ms).
+ */
+int power_governor_http_wait_ms(int configured) {
+    return cap(configured, tier_limits[current_tier].max_http_wait_ms);
+}
+
+/**
+ * @brief Stretches "every N refreshes" counters (deghosting clear, forced full waveform).
+ */
+int power_governor_refresh_count(int configured) {
+    return configured * tier_limits[current_tier].interval_factor;
+}
+
+/**
+ * @brief Returns true if the fast waveform should be used even if `fast_refresh_mode` is off.
+ */
+bool power_governor_prefer_fast_refresh(void) {
+    return current_tier >= POWER_TIER_SAVING;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file power_governor.h
+ * @brief Battery-voltage driven power tiers.
+ *
+ * The tier is chosen once per wake from the battery voltage measured at boot.
+ * Lower tiers stretch the wake interval, cap the Wi-Fi budget and prefer the
+ * fast panel waveforms; below `switch_off_battery_voltage` a "replace batteries"
+ * frame is shown and no further RTC wake-ups are scheduled.
+ */
+
+#pragma once
+#include <stdbool.h>
+
+#define POWER_GOVERNOR_HYSTERESIS   0.05f   ///< Volts above a threshold before a better tier is used again
+
+typedef enum {
+    POWER_TIER_NORMAL = 0,     ///< Configured behaviour
+    POWER_TIER_SAVING,         ///< Below power_saving_voltage
+    POWER_TIER_CRITICAL,       ///< Below power_critical_voltage
+    POWER_TIER_SHUTDOWN,       ///< Below switch_off_battery_voltage: final frame, no more alarms
+    POWER_TIER_COUNT
+} power_tier_t;
+
+void power_governor_init(float battery_voltage);
+power_tier_t power_governor_tier(void);
+const char* power_tier_name(power_tier_t tier);
+
+int power_governor_refresh_minutes(int minutes);
+int power_governor_wifi_attempts(int configured);
+int power_governor_wifi_timeout_ms(int configured);
+int power_governor_http_wait_ms(int configured);
+int power_governor_refresh_count(int configured);
+bool power_governor_prefer_fast_refresh(void);
@@ -0,0 +1,279 @@
+/**
+ * @file schedule.c
+ * @brief Weekly wake schedule and closure days (device configuration).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include "schedule.h"
+#include "main.h"
+
+#define MINUTES_PER_DAY (24 * 60)
+
+static const char* const weekday_names[7] = {"Mo", "Tu", "We", "Th", "Fr", "Sa", "Su"};
+
+/**
+ * @brief Returns true for a usable window: known weekdays, start < end within one day
+ * and an interval of at most one day (the limits of schedule_parse_windows()).
+ *
+ * Anything else (unused slots, erased or corrupt flash) is ignored.
+ */
+static bool window_valid(const schedule_window_t* w) {
+    return w->days != 0 && w->days <= 0x7F && w->start_minute < w->end_minute &&
+           w->end_minute <= MINUTES_PER_DAY && w->interval_minutes <= MINUTES_PER_DAY;
+}
+
+/**
+ * @brief Returns true if the schedule applies (`query_only_at_officehours`) and has at least one valid window.
+ */
+bool schedule_is_active(const device_config_data_t* cfg) {
+    if (!cfg->query_only_at_officehours) {
+        return false;
+    }
+    for (int i = 0; i < SCHEDULE_MAX_WINDOWS; i++) {
+        if (window_valid(&cfg->schedule_windows[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool is_holiday(const device_config_data_t* cfg, const ds3231_data_t* date) {
+    for (int i = 0; i < SCHEDULE_MAX_HOLIDAYS; i++) {
+        const schedule_holiday_t* h = &cfg->holidays[i];
+        if (h->month != 0 && h->month == date->month && h->date == date->date &&
+            (h->year == 0 || h->year == date->year)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool window_valid_on(const schedule_window_t* w, int weekday) {
+    return window_valid(w) && (w->days & (1 << (weekday - 1)));
+}
+
+/**
+ * @brief Returns the window that contains the given local time, or NULL (closed, holiday).
+ */
+const schedule_window_t* schedule_window_at(const device_config_data_t* cfg, uint32_t local_minutes) {
+    ds3231_data_t date;
+    rtc_minutes_to_time(local_minutes, &date);
+    uint32_t minute_of_day = local_minutes % MINUTES_PER_DAY;
+
+    if (is_holiday(cfg, &date)) {
+        return NULL;
+    }
+    for (int i = 0; i < SCHEDULE_MAX_WINDOWS; i++) {
+        const schedule_window_t* w = &cfg->schedule_windows[i];
+        if (window_valid_on(w, date.day) && minute_of_day >= w->start_minute && minute_of_day < w->end_minute) {
+            return w;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Returns the first time >= `local_minutes` that lies in a schedule window.
+ *
+ * Days are searched up to `limit`; if no window opens before, `limit` is returned.
+ */
+uint32_t schedule_next_open(const device_config_data_t* cfg, uint32_t local_minutes, uint32_t limit) {
+    for (uint32_t day_start = local_minutes - local_minutes % MINUTES_PER_DAY; day_start < limit;
+         day_start += MINUTES_PER_DAY) {
+        ds3231_data_t date;
+        rtc_minutes_to_time(day_start, &date);
+        if (is_holiday(cfg, &date)) {
+            continue;
+        }
+
+        uint32_t best = UINT32_MAX;
+        for (int i = 0; i < SCHEDULE_MAX_WINDOWS; i++) {
+            const schedule_window_t* w = &cfg->schedule_windows[i];
+            uint32_t open = day_start + w->start_minute;
+            uint32_t close = day_start + w->end_minute;
+            if (!window_valid_on(w, date.day) || local_minutes >= close) {
+                continue;
+            }
+            uint32_t candidate = (local_minutes > open) ? local_minutes : open;
+            if (candidate < best) best = candidate;
+        }
+        if (best != UINT32_MAX) {
+            return (best < limit) ? best : limit;
+        }
+    }
+    return limit;
+}
+
+static int parse_weekday(const char* s) {
+    for (int i = 0; i < 7; i++) {
+        if (strncasecmp(s, weekday_names[i], 2) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Parses the text form of the schedule windows.
+ *
+ * @return Number of windows, or -1 on a syntax error (`out` is then undefined).
+ */
+int schedule_parse_windows(const char* text, schedule_window_t* out, int max) {
+    const char* p = text;
+    int count = 0;
+
+    memset(out, 0, sizeof(*out) * max);
+
+    while (true) {
+        while (*p == ' ' || *p == ';') p++;
+        if (*p == '\0') break;
+        if (count >= max) return -1;
+
+        // Weekdays: "Mo-Fr", "Sa", "Mo,We,Fr"
+        uint8_t days = 0;
+        while (true) {
+            int first = parse_weekday(p);
+            if (first < 0) break;
+            p += 2;
+            int last = first;
+            if (*p == '-' && parse_weekday(p + 1) >= 0) {
+                last = parse_weekday(p + 1);
+                p += 3;
+            }
+            for (int d = first; ; d = (d + 1) % 7) {
+                days |= 1 << d;
+                if (d == last) break;
+            }
+            if (*p != ',') break;
+            p++;
+        }
+
+        int start_h, start_m, end_h, end_m, consumed = 0;
+        if (days == 0 || sscanf(p, " %d:%d-%d:%d%n", &start_h, &start_m, &end_h, &end_m, &consumed) != 4) {
+            return -1;
+        }
+        p += consumed;
+
+        int interval = 0;
+        if (sscanf(p, " %d%n", &interval, &consumed) == 1) {
+            p += consumed;
+        }
+
+        int start = start_h * 60 + start_m;
+        int end = end_h * 60 + end_m;
+        if (start_m < 0 || start_m > 59 || end_m < 0 || end_m > 59 || start < 0 ||
+            end > MINUTES_PER_DAY || end <= start || interval < 0 || interval > MINUTES_PER_DAY) {
+            return -1;
+        }
+
+        out[count].days = days;
+        out[count].start_minute = start;
+        out[count].end_minute = end;
+        out[count].interval_minutes = interval;
+        count++;
+
+        while (*p == ' ') p++;
+        if (*p != '\0' && *p != ';') return -1;
+    }
+    return count;
+}
+
+/**
+ * @brief Parses the text form of the closure days.
+ *
+ * @return Number of days, or -1 on a syntax error.
+ */
+int schedule_parse_holidays(const char* text, schedule_holiday_t* out, int max) {
+    const char* p = text;
+    int count = 0;
+
+    memset(out, 0, sizeof(*out) * max);
+
+    while (true) {
+        while (*p == ' ' || *p == ',' || *p == ';') p++;
+        if (*p == '\0') break;
+        if (count >= max) return -1;
+
+        int a, b, c, consumed = 0;
+        int year = 0, month, date;
+        if (sscanf(p, "%d-%d-%d%n", &a, &b, &c, &consumed) == 3) {
+            year = a - 2000;
+            month = b;
+            date = c;
+        } else if (sscanf(p, "%d-%d%n", &a, &b, &consumed) == 2) {
+            month = a;
+            date = b;
+        } else {
+            return -1;
+        }
+        if (year < 0 || year > 99 || month < 1 || month > 12 || date < 1 || date > 31) {
+            return -1;
+        }
+        p += consumed;
+
+        out[count].year = year;
+        out[count].month = month;
+        out[count].date = date;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Formats the schedule windows in their text form (see schedule.h).
+ */
+void schedule_format_windows(const schedule_window_t* windows, int count, char* buffer, size_t buffer_size) {
+    size_t len = 0;
+    buffer[0] = '\0';
+
+    for (int i = 0; i < count && len < buffer_size; i++) {
+        const schedule_window_t* w = &windows[i];
+        if (!window_valid(w)) continue;
+
+        if (len > 0) len += snprintf(buffer + len, buffer_size - len, "; ");
+
+        // Runs of consecutive days: "Mo-Fr", single days separated by ','
+        bool first_run = true;
+        for (int d = 0; d < 7 && len < buffer_size; d++) {
+            if (!(w->days & (1 << d))) continue;
+            int end = d;
+            while (end < 6 && (w->days & (1 << (end + 1)))) end++;
+            len += snprintf(buffer + len, buffer_size - len, "%s%s", first_run ? "" : ",", weekday_names[d]);
+            if (end > d && len < buffer_size) {
+                len += snprintf(buffer + len, buffer_size - len, "-%s", weekday_names[end]);
+            }
+            first_run = false;
+            d = end;
+        }
+
+        if (len < buffer_size) {
+            len += snprintf(buffer + len, buffer_size - len, " %02d:%02d-%02d:%02d",
+                            w->start_minute / 60, w->start_minute % 60, w->end_minute / 60, w->end_minute % 60);
+        }
+        if (w->interval_minutes > 0 && len < buffer_size) {
+            len += snprintf(buffer + len, buffer_size - len, " %d", w->interval_minutes);
+        }
+    }
+}
+
+/**
+ * @brief Formats the closure days in their text form (see schedule.h).
+ */
+void schedule_format_holidays(const schedule_holiday_t* holidays, int count, char* buffer, size_t buffer_size) {
+    size_t len = 0;
+    buffer[0] = '\0';
+
+    for (int i = 0; i < count && len < buffer_size; i++) {
+        const schedule_holiday_t* h = &holidays[i];
+        if (h->month == 0) continue;
+
+        if (h->year == 0) {
+            len += snprintf(buffer + len, buffer_size - len, "%s%02d-%02d", len ? ", " : "", h->month, h->date);
+        } else {
+            len += snprintf(buffer + len, buffer_size - len, "%s%04d-%02d-%02d", len ? ", " : "",
+                            2000 + h->year, h->month, h->date);
+        }
+    }
+}
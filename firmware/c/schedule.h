@@ -0,0 +1,26 @@
+/**
+ * @file schedule.h
+ * @brief Weekly wake schedule and closure days (device configuration).
+ *
+ * Times are local time (with DST) as minutes since 2000-01-01 00:00, the same
+ * scale as rtc_minutes_since_2000(). The text forms are used by the setup
+ * webserver:
+ *
+ *   windows:  "Mo-Fr 06:00-19:00 30; Sa 08:00-12:00"  (optional interval in minutes)
+ *   holidays: "12-24, 12-25, 2026-04-03"               (MM-DD every year, or YYYY-MM-DD)
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "device_config.h"
+
+bool schedule_is_active(const device_config_data_t* cfg);
+const schedule_window_t* schedule_window_at(const device_config_data_t* cfg, uint32_t local_minutes);
+uint32_t schedule_next_open(const device_config_data_t* cfg, uint32_t local_minutes, uint32_t limit);
+
+int schedule_parse_windows(const char* text, schedule_window_t* out, int max);
+int schedule_parse_holidays(const char* text, schedule_holiday_t* out, int max);
+void schedule_format_windows(const schedule_window_t* windows, int count, char* buffer, size_t buffer_size);
+void schedule_format_holidays(const schedule_holiday_t* holidays, int count, char* buffer, size_t buffer_size);
@@ -28,6 +28,15 @@
 #
 ******************************************************************************/
 #include "DEV_Config.h"
+#include "Debug.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#if DEV_SPI_PIO
+#include "hardware/pio.h"
+#include "epd_spi.pio.h"
+#endif
 
 #define SPI_PORT spi1
 
@@ -54,17 +63,398 @@ UBYTE DEV_Digital_Read(UWORD Pin)
 	return gpio_get(Pin);
 }
 
+/******************************************************************************
+function:	Panel bus transport: spi1, or a PIO transmitter with DEV_SPI_PIO
+Info:
+	DEV_SPI_Put() queues one byte, DEV_SPI_Flush() waits until the last bit
+	is on the wire (the caller may toggle CS/DC afterwards). The PIO program
+	(epd_spi.pio) clocks 4 PIO cycles per bit from clk_sys; its divider is
+	set for SYS_CLK_HZ, the highest clock the clock policy uses, so lower
+	clk_sys levels only slow the bus down. It can invert the bytes in the
+	shifter (DEV_SPI_Set_Inverted()), so inverted planes need no copy.
+******************************************************************************/
+static UDOUBLE spi_hz = DEV_SPI_DEFAULT_HZ;
+
+#if DEV_SPI_PIO
+static PIO spi_pio;
+static uint spi_sm;
+static uint spi_offset;
+static bool spi_pio_ready = false;
+
+static UDOUBLE DEV_SPI_Pio_Divider(UDOUBLE Hz)
+{
+	UDOUBLE div = (SYS_CLK_HZ + 4 * Hz - 1) / (4 * Hz);
+	return div < 1 ? 1 : div;
+}
+
+static void DEV_SPI_Set_Inverted(bool Inverted)
+{
+	// Only called while the state machine is stalled on its pull
+	spi_pio->instr_mem[spi_offset + epd_spi_tx_offset_invert] =
+		Inverted ? pio_encode_mov_not(pio_osr, pio_osr) : pio_encode_mov(pio_osr, pio_osr);
+}
+#endif
+
+static inline void DEV_SPI_Put(UBYTE Value)
+{
+#if DEV_SPI_PIO
+	pio_sm_put_blocking(spi_pio, spi_sm, (uint32_t)Value << 24);
+#else
+	while (!spi_is_writable(SPI_PORT)) {
+		tight_loop_contents();
+	}
+	spi_get_hw(SPI_PORT)->dr = Value;
+#endif
+}
+
+static void DEV_SPI_Flush(void)
+{
+#if DEV_SPI_PIO
+	uint32_t stall = 1u << (PIO_FDEBUG_TXSTALL_LSB + spi_sm);
+	while (!pio_sm_is_tx_fifo_empty(spi_pio, spi_sm)) {
+		tight_loop_contents();
+	}
+	spi_pio->fdebug = stall; // Set again once the last byte is shifted out
+	while (!(spi_pio->fdebug & stall)) {
+		tight_loop_contents();
+	}
+#else
+	spi_hw_t *hw = spi_get_hw(SPI_PORT);
+	while (spi_is_readable(SPI_PORT)) {
+		(void)hw->dr;
+	}
+	while (hw->sr & SPI_SSPSR_BSY_BITS) {
+		tight_loop_contents();
+	}
+	while (spi_is_readable(SPI_PORT)) {
+		(void)hw->dr;
+	}
+	hw->icr = SPI_SSPICR_RORIC_BITS;
+#endif
+}
+
 /**
  * SPI
 **/
 void DEV_SPI_WriteByte(uint8_t Value)
 {
-    spi_write_blocking(SPI_PORT, &Value, 1);
+	DEV_SPI_Put(Value);
+	DEV_SPI_Flush();
+}
+
+void DEV_SPI_Write_nByte(const uint8_t *pData, uint32_t Len)
+{
+	for (uint32_t i = 0; i < Len; i++) {
+		DEV_SPI_Put(pData[i]);
+	}
+	DEV_SPI_Flush();
+}
+
+/******************************************************************************
+function:	Set the panel bus clock
+parameter:
+	Hz : requested clock, the next lower one the hardware can make is used
+Info:
+	Returns the actual clock. May be called before DEV_Module_Init(); must
+	not be called while a stream is running.
+******************************************************************************/
+UDOUBLE DEV_SPI_Set_Baudrate(UDOUBLE Hz)
+{
+#if DEV_SPI_PIO
+	UDOUBLE div = DEV_SPI_Pio_Divider(Hz);
+	spi_hz = SYS_CLK_HZ / (4 * div);
+	if (spi_pio_ready) {
+		pio_sm_set_clkdiv_int_frac(spi_pio, spi_sm, div, 0);
+	}
+#else
+	spi_hz = (spi_get_hw(SPI_PORT)->cr1 & SPI_SSPCR1_SSE_BITS) ? spi_set_baudrate(SPI_PORT, Hz) : Hz;
+#endif
+	return spi_hz;
 }
 
-void DEV_SPI_Write_nByte(uint8_t *pData, uint32_t Len)
+UDOUBLE DEV_SPI_Get_Baudrate(void)
 {
-    spi_write_blocking(SPI_PORT, pData, Len);
+	return spi_hz;
+}
+
+/******************************************************************************
+function:	Stream a block of display data with CS held low
+parameter:
+	pData  : source bytes (ignored for a fill)
+	Value  : fill byte, or XOR mask applied to every source byte
+	Len    : number of bytes
+Info:
+	DC is set once and the TX FIFO is kept full, so the clock runs without
+	the gaps of one CS/DC toggle and one blocking call per byte. The RX FIFO
+	is drained like spi_write_blocking() does. With DEV_SPI_BURST 0 the old
+	byte-wise transfer is used (for comparing DEV_SPI_Time_us()).
+******************************************************************************/
+static UDOUBLE spi_total_us = 0;
+
+static void DEV_SPI_Burst(const UBYTE *pData, UBYTE Value, UDOUBLE Len)
+{
+	absolute_time_t start = get_absolute_time();
+
+#if DEV_SPI_BURST
+	DEV_Digital_Write(EPD_DC_PIN, 1);
+	DEV_Digital_Write(EPD_CS_PIN, 0);
+	for (UDOUBLE i = 0; i < Len; i++) {
+		DEV_SPI_Put(pData ? (UBYTE)(pData[i] ^ Value) : Value);
+	}
+	DEV_SPI_Flush();
+	DEV_Digital_Write(EPD_CS_PIN, 1);
+#else
+	for (UDOUBLE i = 0; i < Len; i++) {
+		UBYTE Data = pData ? (UBYTE)(pData[i] ^ Value) : Value;
+		DEV_Digital_Write(EPD_DC_PIN, 1);
+		DEV_Digital_Write(EPD_CS_PIN, 0);
+		DEV_SPI_WriteByte(Data);
+		DEV_Digital_Write(EPD_CS_PIN, 1);
+	}
+#endif
+
+	spi_total_us += (UDOUBLE)absolute_time_diff_us(start, get_absolute_time());
+}
+
+/**
+ * display data: copy, inverted copy (~pData) and constant fill
+**/
+void DEV_SPI_SendData_nByte(const UBYTE *pData, UDOUBLE Len)
+{
+	DEV_SPI_Burst(pData, 0x00, Len);
+}
+
+void DEV_SPI_SendData_nByte_Inverted(const UBYTE *pData, UDOUBLE Len)
+{
+	DEV_SPI_Burst(pData, 0xFF, Len);
+}
+
+void DEV_SPI_SendData_Fill(UBYTE Value, UDOUBLE Len)
+{
+	DEV_SPI_Burst(NULL, Value, Len);
+}
+
+/**
+ * time spent in display data transfers since boot (us)
+**/
+UDOUBLE DEV_SPI_Time_us(void)
+{
+	return spi_total_us;
+}
+
+/******************************************************************************
+function:	Stream display planes to the panel by DMA
+parameter:
+	Planes : up to DEV_SPI_MAX_PLANES planes, copied (may live on the stack)
+	Count  : number of planes
+Info:
+	Each plane is preceded by its command byte (unless DEV_SPI_NO_COMMAND)
+	and sent with CS held low. A plane is one transfer if its rows are
+	contiguous, a window one transfer per row, read straight from the
+	framebuffer. Inverted planes go through a small bounce buffer that the
+	interrupt refills while the TX FIFO still holds the previous chunk,
+	so the frame is never copied as a whole; the PIO transport inverts in
+	the shifter instead.
+	The core sleeps in DEV_SPI_Stream_Wait() until the last byte is out.
+	With DEV_SPI_BURST 0, or if no DMA channel is free, the planes are sent
+	by DEV_SPI_Burst() instead.
+******************************************************************************/
+#define DEV_SPI_STREAM_IRQ   DMA_IRQ_1
+#define DEV_SPI_BOUNCE_LEN   256
+
+static DEV_SPI_Plane stream_planes[DEV_SPI_MAX_PLANES];
+static UBYTE stream_count;
+static UBYTE stream_plane;
+static UDOUBLE stream_row;              // next row of the current plane
+static UDOUBLE stream_offset;           // next byte within that row (inverted planes)
+static volatile bool stream_busy = false;
+static absolute_time_t stream_start;
+static int stream_chan = -1;
+static UBYTE stream_bounce[DEV_SPI_BOUNCE_LEN];
+
+static void DEV_SPI_Stream_Finish_Plane(void)
+{
+	DEV_SPI_Flush();
+#if DEV_SPI_PIO
+	DEV_SPI_Set_Inverted(false);
+#endif
+	DEV_Digital_Write(EPD_CS_PIN, 1);
+}
+
+static void DEV_SPI_Stream_Begin_Plane(const DEV_SPI_Plane *Plane)
+{
+	DEV_Digital_Write(EPD_CS_PIN, 0);
+	if (Plane->Command != DEV_SPI_NO_COMMAND) {
+		DEV_Digital_Write(EPD_DC_PIN, 0);
+		DEV_SPI_WriteByte((UBYTE)Plane->Command);
+	}
+	DEV_Digital_Write(EPD_DC_PIN, 1);
+#if DEV_SPI_PIO
+	DEV_SPI_Set_Inverted(Plane->Inverted);
+#endif
+}
+
+/**
+ * next DMA transfer of the stream, false when all planes are sent
+**/
+static bool DEV_SPI_Stream_Next(void)
+{
+	while (stream_plane < stream_count) {
+		const DEV_SPI_Plane *Plane = &stream_planes[stream_plane];
+		bool contiguous = (Plane->Stride == Plane->Row_Len) || (Plane->Rows == 1);
+		UDOUBLE row_len = contiguous ? Plane->Row_Len * Plane->Rows : Plane->Row_Len;
+		UDOUBLE rows = contiguous ? 1 : Plane->Rows;
+
+		if (stream_row < rows && row_len > 0) {
+			const UBYTE *src = Plane->Data + stream_row * Plane->Stride;
+			UDOUBLE len;
+
+			if (Plane->Inverted && !DEV_SPI_PIO) {
+				len = row_len - stream_offset;
+				if (len > DEV_SPI_BOUNCE_LEN) {
+					len = DEV_SPI_BOUNCE_LEN;
+				}
+				for (UDOUBLE i = 0; i < len; i++) {
+					stream_bounce[i] = ~src[stream_offset + i];
+				}
+				stream_offset += len;
+				if (stream_offset >= row_len) {
+					stream_offset = 0;
+					stream_row++;
+				}
+				src = stream_bounce;
+			} else {
+				len = row_len;
+				stream_row++;
+			}
+			dma_channel_transfer_from_buffer_now(stream_chan, src, len);
+			return true;
+		}
+
+		DEV_SPI_Stream_Finish_Plane();
+		stream_plane++;
+		stream_row = 0;
+		stream_offset = 0;
+		if (stream_plane < stream_count) {
+			DEV_SPI_Stream_Begin_Plane(&stream_planes[stream_plane]);
+		}
+	}
+	return false;
+}
+
+static void DEV_SPI_Stream_IRQ(void)
+{
+	if (stream_chan < 0 || !dma_channel_get_irq1_status(stream_chan)) {
+		return;
+	}
+	dma_channel_acknowledge_irq1(stream_chan);
+
+	if (!DEV_SPI_Stream_Next()) {
+		dma_channel_set_irq1_enabled(stream_chan, false);
+		spi_total_us += (UDOUBLE)absolute_time_diff_us(stream_start, get_absolute_time());
+		stream_busy = false;
+		__sev();
+	}
+}
+
+static bool DEV_SPI_Stream_Start(const DEV_SPI_Plane *Planes, UBYTE Count)
+{
+	if (stream_busy || Count == 0 || Count > DEV_SPI_MAX_PLANES) {
+		return false;
+	}
+
+	if (stream_chan < 0) {
+		stream_chan = dma_claim_unused_channel(false);
+		if (stream_chan < 0) {
+			return false;
+		}
+		dma_channel_config cfg = dma_channel_get_default_config(stream_chan);
+		channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+		channel_config_set_read_increment(&cfg, true);
+		channel_config_set_write_increment(&cfg, false);
+#if DEV_SPI_PIO
+		// 8-bit writes are replicated to all byte lanes, the program shifts out bits 31..24
+		channel_config_set_dreq(&cfg, pio_get_dreq(spi_pio, spi_sm, true));
+		dma_channel_configure(stream_chan, &cfg, &spi_pio->txf[spi_sm], NULL, 0, false);
+#else
+		channel_config_set_dreq(&cfg, spi_get_dreq(SPI_PORT, true));
+		dma_channel_configure(stream_chan, &cfg, &spi_get_hw(SPI_PORT)->dr, NULL, 0, false);
+#endif
+		irq_add_shared_handler(DEV_SPI_STREAM_IRQ, DEV_SPI_Stream_IRQ, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+	}
+
+	for (UBYTE i = 0; i < Count; i++) {
+		stream_planes[i] = Planes[i];
+	}
+	stream_count = Count;
+	stream_plane = 0;
+	stream_row = 0;
+	stream_offset = 0;
+	stream_start = get_absolute_time();
+	stream_busy = true;
+
+	// The interrupt is served by the core that started the stream
+	dma_channel_acknowledge_irq1(stream_chan);
+	dma_channel_set_irq1_enabled(stream_chan, true);
+	irq_set_enabled(DEV_SPI_STREAM_IRQ, true);
+
+	DEV_SPI_Stream_Begin_Plane(&stream_planes[0]);
+	if (!DEV_SPI_Stream_Next()) {
+		// Only empty planes: complete without a transfer
+		dma_channel_set_irq1_enabled(stream_chan, false);
+		stream_busy = false;
+	}
+	return true;
+}
+
+/**
+ * sleep until the stream is complete
+**/
+static void DEV_SPI_Stream_Wait(void)
+{
+	if (!stream_busy) {
+		return;
+	}
+#if !DEV_SPI_PIO
+	DEV_Wait_Hook(); // The PIO bit clock follows clk_sys, keep it up
+#endif
+	while (stream_busy) {
+		__wfe();
+	}
+}
+
+/**
+ * the same planes without DMA: command, then each row by DEV_SPI_Burst()
+**/
+static void DEV_SPI_Stream_Blocking(const DEV_SPI_Plane *Planes, UBYTE Count)
+{
+	for (UBYTE i = 0; i < Count; i++) {
+		const DEV_SPI_Plane *Plane = &Planes[i];
+		if (Plane->Command != DEV_SPI_NO_COMMAND) {
+			DEV_Digital_Write(EPD_DC_PIN, 0);
+			DEV_Digital_Write(EPD_CS_PIN, 0);
+			DEV_SPI_WriteByte((UBYTE)Plane->Command);
+			DEV_Digital_Write(EPD_CS_PIN, 1);
+		}
+		for (UDOUBLE row = 0; row < Plane->Rows; row++) {
+			DEV_SPI_Burst(Plane->Data + row * Plane->Stride, Plane->Inverted ? 0xFF : 0x00, Plane->Row_Len);
+		}
+	}
+}
+
+/**
+ * stream one or more planes, returns when they are sent
+**/
+void DEV_SPI_Stream(const DEV_SPI_Plane *Planes, UBYTE Count)
+{
+	if (DEV_SPI_BURST) {
+		if (DEV_SPI_Stream_Start(Planes, Count)) {
+			DEV_SPI_Stream_Wait();
+			return;
+		}
+		Debug("DMA stream not started, blocking transfer\r\n");
+	}
+	DEV_SPI_Stream_Blocking(Planes, Count); // Byte-wise with DEV_SPI_BURST 0
 }
 
 /**
@@ -80,14 +470,96 @@ void DEV_GPIO_Mode(UWORD Pin, UWORD Mode)
 	}
 }
 
+/**
+ * wait hook, called before every delay; the application may override it
+ * (e.g. to lower the system clock while the panel is busy)
+**/
+__attribute__((weak)) void DEV_Wait_Hook(void)
+{
+}
+
 /**
  * delay x ms
 **/
 void DEV_Delay_ms(UDOUBLE xms)
 {
+	DEV_Wait_Hook();
 	sleep_ms(xms);
 }
 
+/**
+ * BUSY wait
+**/
+static volatile bool busy_released = false;
+static UDOUBLE busy_events = 0;
+static UDOUBLE busy_total_ms = 0;
+
+static void DEV_Busy_IRQ(void)
+{
+	if (gpio_get_irq_event_mask(EPD_BUSY_PIN) & busy_events) {
+		gpio_acknowledge_irq(EPD_BUSY_PIN, busy_events);
+		busy_released = true;
+	}
+}
+
+/******************************************************************************
+function:	Wait until the BUSY pin reaches the idle level
+parameter:
+	Idle_Level : level of the BUSY pin while the controller is idle
+	Timeout_ms : give up after this time
+Info:
+	Instead of polling, an edge interrupt on the BUSY pin is armed and the
+	core sleeps (WFE) until the edge or the timeout. The busy time is added
+	to DEV_Busy_Time_ms().
+	Returns 0 when the controller is idle, 1 on timeout (refresh not done).
+******************************************************************************/
+UBYTE DEV_Wait_Busy(UBYTE Idle_Level, UDOUBLE Timeout_ms)
+{
+	static bool handler_added = false;
+	UBYTE timed_out = 0;
+
+	if (gpio_get(EPD_BUSY_PIN) == Idle_Level) {
+		return 0;
+	}
+
+	DEV_Wait_Hook();
+
+	absolute_time_t start = get_absolute_time();
+	absolute_time_t deadline = make_timeout_time_ms(Timeout_ms);
+
+	if (!handler_added) {
+		gpio_add_raw_irq_handler(EPD_BUSY_PIN, DEV_Busy_IRQ);
+		handler_added = true;
+	}
+	busy_events = Idle_Level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+	busy_released = false;
+	gpio_acknowledge_irq(EPD_BUSY_PIN, busy_events);
+	gpio_set_irq_enabled(EPD_BUSY_PIN, busy_events, true);
+	irq_set_enabled(IO_IRQ_BANK0, true);
+
+	// The pin is checked again after arming, an edge before that is not lost
+	while (!busy_released && gpio_get(EPD_BUSY_PIN) != Idle_Level) {
+		if (best_effort_wfe_or_timeout(deadline)) {
+			Debug("e-Paper BUSY timeout after %lu ms\r\n", (unsigned long)Timeout_ms);
+			timed_out = 1;
+			break;
+		}
+	}
+
+	gpio_set_irq_enabled(EPD_BUSY_PIN, busy_events, false);
+
+	busy_total_ms += (UDOUBLE)(absolute_time_diff_us(start, get_absolute_time()) / 1000);
+	return timed_out;
+}
+
+/**
+ * BUSY time since boot (ms)
+**/
+UDOUBLE DEV_Busy_Time_ms(void)
+{
+	return busy_total_ms;
+}
+
 void DEV_GPIO_Init(void)
 {
 
@@ -113,14 +585,25 @@ Info:
 ******************************************************************************/
 UBYTE DEV_Module_Init(void)
 {
-    stdio_init_all();
+	// stdio is set up by the application (deferred on button wakes)
 
 	// GPIO Config
 	DEV_GPIO_Init();
 	
-    spi_init(SPI_PORT, 4000 * 1000);
+#if DEV_SPI_PIO
+    if (!spi_pio_ready) {
+        if (!pio_claim_free_sm_and_add_program(&epd_spi_tx_program, &spi_pio, &spi_sm, &spi_offset)) {
+            Debug("No free PIO state machine for the panel bus\r\n");
+            return 1;
+        }
+        spi_pio_ready = true;
+    }
+    epd_spi_tx_program_init(spi_pio, spi_sm, spi_offset, EPD_MOSI_PIN, EPD_CLK_PIN, DEV_SPI_Pio_Divider(spi_hz));
+#else
+    spi_hz = spi_init(SPI_PORT, spi_hz);
     gpio_set_function(EPD_CLK_PIN, GPIO_FUNC_SPI);
     gpio_set_function(EPD_MOSI_PIN, GPIO_FUNC_SPI);
+#endif
 	
 //    printf("DEV_Module_Init OK \r\n");
 	return 0;
@@ -59,6 +59,18 @@
 #define UWORD   uint16_t
 #define UDOUBLE uint32_t
 
+#define DEV_BUSY_TIMEOUT_MS 60000   // longest refresh incl. 7-colour panels
+
+#ifndef DEV_SPI_BURST
+#define DEV_SPI_BURST 1             // 0 = byte-wise display data (CS toggled per byte)
+#endif
+
+#ifndef DEV_SPI_PIO
+#define DEV_SPI_PIO 0               // 1 = PIO transmitter on the SPI pins instead of spi1
+#endif
+
+#define DEV_SPI_DEFAULT_HZ  4000000 // Waveshare default, safe for every panel
+
 /**
  * GPIOI config
 **/
@@ -69,13 +81,38 @@ extern int EPD_BUSY_PIN;
 extern int EPD_CLK_PIN;
 extern int EPD_MOSI_PIN;
 
+/**
+ * DMA frame streaming
+**/
+#define DEV_SPI_MAX_PLANES  4
+#define DEV_SPI_NO_COMMAND  0xFFFF
+
+typedef struct {
+	UWORD Command;          // command byte sent before the data, or DEV_SPI_NO_COMMAND
+	const UBYTE *Data;      // first byte of the plane or window
+	UDOUBLE Row_Len;        // bytes per row
+	UDOUBLE Rows;           // number of rows
+	UDOUBLE Stride;         // distance of two rows in Data (Row_Len for a full plane)
+	bool Inverted;          // send ~Data
+} DEV_SPI_Plane;
+
 /*------------------------------------------------------------------------------------------------------*/
 void DEV_Digital_Write(UWORD Pin, UBYTE Value);
 UBYTE DEV_Digital_Read(UWORD Pin);
 
 void DEV_SPI_WriteByte(UBYTE Value);
-void DEV_SPI_Write_nByte(uint8_t *pData, uint32_t Len);
+void DEV_SPI_Write_nByte(const uint8_t *pData, uint32_t Len);
+void DEV_SPI_SendData_nByte(const UBYTE *pData, UDOUBLE Len);
+void DEV_SPI_SendData_nByte_Inverted(const UBYTE *pData, UDOUBLE Len);
+void DEV_SPI_SendData_Fill(UBYTE Value, UDOUBLE Len);
+UDOUBLE DEV_SPI_Time_us(void);
+UDOUBLE DEV_SPI_Set_Baudrate(UDOUBLE Hz);
+UDOUBLE DEV_SPI_Get_Baudrate(void);
+void DEV_SPI_Stream(const DEV_SPI_Plane *Planes, UBYTE Count);
 void DEV_Delay_ms(UDOUBLE xms);
+void DEV_Wait_Hook(void);
+UBYTE DEV_Wait_Busy(UBYTE Idle_Level, UDOUBLE Timeout_ms); // 0 = idle, 1 = timeout
+UDOUBLE DEV_Busy_Time_ms(void);
 
 UBYTE DEV_Module_Init(void);
 void DEV_Module_Exit(void);
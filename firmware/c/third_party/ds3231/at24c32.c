@@ -11,6 +11,8 @@
  */
 
  #include "ds3231.h"
+ #include <string.h>
+ #include "pico/time.h"
 
 /**
  * @brief                   Library function to write to a page of an I2C EEPROM.
@@ -128,3 +130,79 @@ int at24c32_write_current_time(ds3231_t * rtc, uint8_t page_addr) {
     return 0;
 }
 
+
+/**
+ * @brief                   Read an arbitrary range of the AT24C32 EEPROM.
+ * The device auto-increments its internal address counter, so the whole range
+ * is read in a single sequential read transaction.
+ *
+ * @param[in] rtc           DS3231 struct (provides I2C instance and EEPROM adress).
+ * @param[in] address       12-bit memory adress to start reading from.
+ * @param[out] data         Pointer to the data buffer.
+ * @param[in] length        Number of bytes to read.
+ * @return                  0 if succesful, -1 if i2c failure or range exceeds memory.
+ */
+int at24c32_read(ds3231_t * rtc, uint16_t address, uint8_t * data, size_t length) {
+    if(!length || ((size_t)address + length) > AT24C32_SIZE)
+        return -1;
+    uint8_t messeage[2];
+    messeage[0] = (uint8_t)(address >> 8);
+    messeage[1] = (uint8_t)(address & 0xFF);
+    if(i2c_write_blocking(rtc->i2c, rtc->at24c32_addr, messeage, 2, true) < 0)
+        return -1;
+    if(i2c_read_blocking(rtc->i2c, rtc->at24c32_addr, data, length, false) < 0)
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief                   Wait until the EEPROM has finished its internal write cycle.
+ * The AT24C32 does not acknowledge its adress while a write cycle is in progress
+ * (acknowledge polling), which is faster than waiting the worst case tWR.
+ *
+ * @param[in] rtc           DS3231 struct.
+ * @return                  0 if the device is ready, -1 on timeout.
+ */
+static int at24c32_wait_write_cycle(ds3231_t * rtc) {
+    uint8_t dummy[2] = {0, 0};
+    for(int i = 0; i <= AT24C32_WRITE_CYCLE_MS; i++) {
+        if(i2c_write_timeout_us(rtc->i2c, rtc->at24c32_addr, dummy, 2, false, 1000) == 2)
+            return 0;
+        sleep_ms(1);
+    }
+    return -1;
+}
+
+/**
+ * @brief                   Write an arbitrary range to the AT24C32 EEPROM.
+ * The data is split at 32 byte page boundaries, since a page write wraps
+ * around inside the page otherwise. Every page write is followed by
+ * acknowledge polling so consecutive calls are safe.
+ *
+ * @param[in] rtc           DS3231 struct (provides I2C instance and EEPROM adress).
+ * @param[in] address       12-bit memory adress to start writing to.
+ * @param[in] data          Pointer to the data buffer.
+ * @param[in] length        Number of bytes to write.
+ * @return                  0 if succesful, -1 if i2c failure or range exceeds memory.
+ */
+int at24c32_write(ds3231_t * rtc, uint16_t address, const uint8_t * data, size_t length) {
+    if(!length || ((size_t)address + length) > AT24C32_SIZE)
+        return -1;
+    uint8_t messeage[AT24C32_PAGE_SIZE + 2];
+    while(length) {
+        size_t chunk = AT24C32_PAGE_SIZE - (address % AT24C32_PAGE_SIZE);
+        if(chunk > length)
+            chunk = length;
+        messeage[0] = (uint8_t)(address >> 8);
+        messeage[1] = (uint8_t)(address & 0xFF);
+        memcpy(&messeage[2], data, chunk);
+        if(i2c_write_blocking(rtc->i2c, rtc->at24c32_addr, messeage, chunk + 2, false) < 0)
+            return -1;
+        if(at24c32_wait_write_cycle(rtc))
+            return -1;
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return 0;
+}
@@ -719,7 +719,8 @@ int ds3231_read_temperature(ds3231_t * rtc, float * temperature) {
     if(i2c_read_reg(rtc->i2c, rtc->ds3231_addr, DS3231_TEMPERATURE_MSB_REG, 2, temp))
         return -1;
     
-    *temperature = temp[0] + (float)(1 / (temp[1] >> 6));
+    /* MSB is a two's complement integer, bits 7:6 of the LSB are quarter degrees. */
+    *temperature = (int8_t)temp[0] + (temp[1] >> 6) * 0.25f;
     return 0;
 }
 
@@ -755,6 +756,21 @@ int ds3231_set_aging_offset(ds3231_t * rtc, int8_t offset) {
     return 0;
 }
 
+/** 
+ * @brief               Read the aging offset currently programmed in the ds3231.
+ * 
+ * @param[in] rtc       DS3231 struct.  
+ * @param[out] offset   Offset value in two's complement.
+ * @return              0 if succesful.
+ */
+int ds3231_get_aging_offset(ds3231_t * rtc, int8_t * offset) {
+    uint8_t aging_offset = 0;
+    if(i2c_read_reg(rtc->i2c, rtc->ds3231_addr, DS3231_AGING_OFFSET_REG, 1, &aging_offset))
+        return -1;
+    *offset = (int8_t)aging_offset;
+    return 0;
+}
+
 /**
  * @brief               Set a interrupt callback function to trigger whenever DS3231 sends an alarm signal.
  * Each core in RP2040 can only have a interrupt single callback function. 
@@ -33,6 +33,8 @@ adress can be changed by soldering jumpers to A0, A1 and A2 inputs on the module
 
 #define AT24C32_PAGE_COUNT              256     
 #define AT24C32_PAGE_SIZE               32      // Bytes
+#define AT24C32_SIZE                    4096    // Bytes (32 kbit)
+#define AT24C32_WRITE_CYCLE_MS          20      // Max. self-timed write cycle (tWR)
 
 /* Timekeeping Registers */
 #define DS3231_SECONDS_REG              0x00
@@ -172,6 +174,7 @@ int ds3231_force_convert_temperature(ds3231_t * rtc);
 int ds3231_set_square_wave_frequency(ds3231_t * rtc, enum SQUARE_WAVE_FREQUENCY sqr_frq);
 
 int ds3231_set_aging_offset(ds3231_t * rtc, int8_t offset);
+int ds3231_get_aging_offset(ds3231_t * rtc, int8_t * offset);
 
 int ds3231_set_interrupt_callback_function(uint gpio, gpio_irq_callback_t callback);
 
@@ -190,4 +193,8 @@ int at24c32_read_current_adress(i2c_inst_t * i2c, uint8_t dev_addr,
 
 int at24c32_write_current_time(ds3231_t * rtc, uint8_t page_addr);
 
+int at24c32_read(ds3231_t * rtc, uint16_t address, uint8_t * data, size_t length);
+
+int at24c32_write(ds3231_t * rtc, uint16_t address, const uint8_t * data, size_t length);
+
 #endif
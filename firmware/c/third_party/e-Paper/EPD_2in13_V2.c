@@ -135,9 +135,7 @@ parameter:
 void EPD_2IN13_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -170,7 +168,6 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13_V2_Init(UBYTE Mode)
 {
-    UBYTE count;
     EPD_2IN13_V2_Reset();
 
     if(Mode == EPD_2IN13_V2_FULL) {
@@ -221,9 +218,7 @@ void EPD_2IN13_V2_Init(UBYTE Mode)
         EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[75]);
 
         EPD_2IN13_V2_SendCommand(0x32);
-        for(count = 0; count < 70; count++) {
-            EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_full_update[count]);
-        }
+        DEV_SPI_SendData_nByte(EPD_2IN13_V2_lut_full_update, 70);
 
         EPD_2IN13_V2_SendCommand(0x4E);   // set RAM x address count to 0;
         EPD_2IN13_V2_SendData(0x00);
@@ -238,9 +233,7 @@ void EPD_2IN13_V2_Init(UBYTE Mode)
         EPD_2IN13_V2_ReadBusy();
 
         EPD_2IN13_V2_SendCommand(0x32);
-        for(count = 0; count < 70; count++) {
-            EPD_2IN13_V2_SendData(EPD_2IN13_V2_lut_partial_update[count]);
-        }
+        DEV_SPI_SendData_nByte(EPD_2IN13_V2_lut_partial_update, 70);
 
         EPD_2IN13_V2_SendCommand(0x37);
         EPD_2IN13_V2_SendData(0x00);
@@ -275,11 +268,7 @@ void EPD_2IN13_V2_Clear(void)
     Height = EPD_2IN13_V2_HEIGHT;
 
     EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_V2_SendData(0XFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);
 
     EPD_2IN13_V2_TurnOnDisplay();
 }
@@ -295,11 +284,7 @@ void EPD_2IN13_V2_Display(UBYTE *Image)
     Height = EPD_2IN13_V2_HEIGHT;
 
     EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     EPD_2IN13_V2_TurnOnDisplay();
 }
 
@@ -314,21 +299,10 @@ void EPD_2IN13_V2_DisplayPartBaseImage(UBYTE *Image)
     Width = (EPD_2IN13_V2_WIDTH % 8 == 0)? (EPD_2IN13_V2_WIDTH / 8 ): (EPD_2IN13_V2_WIDTH / 8 + 1);
     Height = EPD_2IN13_V2_HEIGHT;
 
-    UDOUBLE Addr = 0;
     EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN13_V2_SendData(Image[Addr]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     EPD_2IN13_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN13_V2_SendData(Image[Addr]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     EPD_2IN13_V2_TurnOnDisplay();
 }
 
@@ -339,11 +313,7 @@ void EPD_2IN13_V2_DisplayPart(UBYTE *Image)
     Width = (EPD_2IN13_V2_WIDTH % 8 == 0)? (EPD_2IN13_V2_WIDTH / 8 ): (EPD_2IN13_V2_WIDTH / 8 + 1);
     Height = EPD_2IN13_V2_HEIGHT;
     EPD_2IN13_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 
     EPD_2IN13_V2_TurnOnDisplayPart();
 }
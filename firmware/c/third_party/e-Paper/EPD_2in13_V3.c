@@ -124,13 +124,8 @@ parameter:
 void EPD_2in13_V3_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(10);
-	}
-	DEV_Delay_ms(10);
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(10);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -165,10 +160,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN13_V3_LUT(UBYTE *lut)
 {
-	UBYTE count;
 	EPD_2in13_V3_SendCommand(0x32);
-	for(count=0; count<153; count++) 
-		EPD_2in13_V3_SendData(lut[count]); 
+	DEV_SPI_SendData_nByte(lut, 153); 
 	EPD_2in13_V3_ReadBusy();
 }
 
@@ -278,13 +271,7 @@ void EPD_2in13_V3_Clear(void)
     Height = EPD_2in13_V3_HEIGHT;
 	
     EPD_2in13_V3_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-            EPD_2in13_V3_SendData(0XFF);
-        }
-    }	
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);	
 
 	EPD_2in13_V3_TurnOnDisplay();
 }
@@ -301,13 +288,7 @@ void EPD_2in13_V3_Display(UBYTE *Image)
     Height = EPD_2in13_V3_HEIGHT;
 	
     EPD_2in13_V3_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-            EPD_2in13_V3_SendData(Image[i + j * Width]);
-        }
-    }	
+    DEV_SPI_SendData_nByte(Image, Height * Width);	
 	
 	EPD_2in13_V3_TurnOnDisplay();	
 }
@@ -325,21 +306,9 @@ void EPD_2in13_V3_Display_Base(UBYTE *Image)
     Height = EPD_2in13_V3_HEIGHT;
 	
 	EPD_2in13_V3_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{        
-			EPD_2in13_V3_SendData(Image[i + j * Width]);
-		}
-	}
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2in13_V3_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-			EPD_2in13_V3_SendData(Image[i + j * Width]);
-		}
-	}
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2in13_V3_TurnOnDisplay();	
 }
 
@@ -385,13 +354,7 @@ void EPD_2in13_V3_Display_Partial(UBYTE *Image)
 	EPD_2in13_V3_SetCursor(0, 0);
 
 	EPD_2in13_V3_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) 
-	{
-        for (UWORD i = 0; i < Width; i++) 
-		{
-			EPD_2in13_V3_SendData(Image[i + j * Width]);
-		}
-	}
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2in13_V3_TurnOnDisplay_Partial();
 }
 
@@ -78,13 +78,8 @@ parameter:
 void EPD_2in13_V4_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(10);
-	}
-	DEV_Delay_ms(10);
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(10);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -230,11 +225,7 @@ void EPD_2in13_V4_Clear(void)
     Height = EPD_2in13_V4_HEIGHT;
 	
     EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(0XFF);
-        }
-    }	
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);	
 
 	EPD_2in13_V4_TurnOnDisplay();
 }
@@ -246,11 +237,7 @@ void EPD_2in13_V4_Clear_Black(void)
     Height = EPD_2in13_V4_HEIGHT;
 	
     EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(0X00);
-        }
-    }	
+    DEV_SPI_SendData_Fill(0X00, Height * Width);	
 
 	EPD_2in13_V4_TurnOnDisplay();
 }
@@ -267,11 +254,7 @@ void EPD_2in13_V4_Display(UBYTE *Image)
     Height = EPD_2in13_V4_HEIGHT;
 	
     EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(Image[i + j * Width]);
-        }
-    }	
+    DEV_SPI_SendData_nByte(Image, Height * Width);	
 	
 	EPD_2in13_V4_TurnOnDisplay();	
 }
@@ -283,11 +266,7 @@ void EPD_2in13_V4_Display_Fast(UBYTE *Image)
     Height = EPD_2in13_V4_HEIGHT;
 	
     EPD_2in13_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in13_V4_SendData(Image[i + j * Width]);
-        }
-    }	
+    DEV_SPI_SendData_nByte(Image, Height * Width);	
 	
 	EPD_2in13_V4_TurnOnDisplay_Fast();	
 }
@@ -305,17 +284,9 @@ void EPD_2in13_V4_Display_Base(UBYTE *Image)
     Height = EPD_2in13_V4_HEIGHT;
 	
 	EPD_2in13_V4_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {        
-			EPD_2in13_V4_SendData(Image[i + j * Width]);
-		}
-	}
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2in13_V4_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-			EPD_2in13_V4_SendData(Image[i + j * Width]);
-		}
-	}
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2in13_V4_TurnOnDisplay();	
 }
 
@@ -350,11 +321,7 @@ void EPD_2in13_V4_Display_Partial(UBYTE *Image)
 	EPD_2in13_V4_SetCursor(0, 0);
 
 	EPD_2in13_V4_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-			EPD_2in13_V4_SendData(Image[i + j * Width]);
-		}
-	}
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2in13_V4_TurnOnDisplay_Partial();
 }
 
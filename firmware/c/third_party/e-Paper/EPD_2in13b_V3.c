@@ -80,13 +80,9 @@ parameter:
 ******************************************************************************/
 void EPD_2IN13B_V3_ReadBusy(void)
 {
-    UBYTE busy;
     Debug("e-Paper busy\r\n");
-    do{
-        EPD_2IN13B_V3_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    }while(busy);
+    EPD_2IN13B_V3_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
     DEV_Delay_ms(200);
 }
@@ -139,19 +135,11 @@ void EPD_2IN13B_V3_Clear(void)
     
     //send black data
     EPD_2IN13B_V3_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V3_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     //send red data
     EPD_2IN13B_V3_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V3_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
     EPD_2IN13B_V3_TurnOnDisplay();
 }
 
@@ -166,18 +154,10 @@ void EPD_2IN13B_V3_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_2IN13B_V3_HEIGHT;
     
     EPD_2IN13B_V3_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V3_SendData(blackimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(blackimage, Height * Width);
     
     EPD_2IN13B_V3_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V3_SendData(ryimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(ryimage, Height * Width);
     EPD_2IN13B_V3_TurnOnDisplay();
 }
 
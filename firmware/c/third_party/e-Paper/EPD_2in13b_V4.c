@@ -78,13 +78,8 @@ parameter:
 void EPD_2IN13B_V4_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(20);
-	}
-	DEV_Delay_ms(20);
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -177,17 +172,9 @@ void EPD_2IN13B_V4_Clear(void)
     Height = EPD_2IN13B_V4_HEIGHT;
 	
     EPD_2IN13B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(0XFF);
-        }
-    }	
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);	
     EPD_2IN13B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(0XFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);
 	EPD_2IN13B_V4_TurnOnDisplay();
 }
 
@@ -202,17 +189,9 @@ void EPD_2IN13B_V4_Display(const UBYTE *blackImage, const UBYTE *redImage)
     Height = EPD_2IN13B_V4_HEIGHT;
 	
     EPD_2IN13B_V4_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(blackImage[i + j * Width]);
-        }
-    }	
+    DEV_SPI_SendData_nByte(blackImage, Height * Width);	
 	EPD_2IN13B_V4_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13B_V4_SendData(redImage[i + j * Width]);
-        }
-    }	
+    DEV_SPI_SendData_nByte(redImage, Height * Width);	
 	EPD_2IN13B_V4_TurnOnDisplay();	
 }
 
@@ -130,9 +130,7 @@ parameter:
 void EPD_2IN13BC_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -186,20 +184,12 @@ void EPD_2IN13BC_Clear(void)
     
     //send black data
     EPD_2IN13BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
     EPD_2IN13BC_SendCommand(0x92); 
 
     //send red data
     EPD_2IN13BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
     EPD_2IN13BC_SendCommand(0x92); 
     
     EPD_2IN13BC_TurnOnDisplay();
@@ -216,19 +206,11 @@ void EPD_2IN13BC_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_2IN13BC_HEIGHT;
     
     EPD_2IN13BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(blackimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(blackimage, Height * Width);
     EPD_2IN13BC_SendCommand(0x92); 
     
     EPD_2IN13BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13BC_SendData(ryimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(ryimage, Height * Width);
     EPD_2IN13BC_SendCommand(0x92); 
     
     EPD_2IN13BC_TurnOnDisplay();
@@ -212,12 +212,8 @@ parameter:
 static void EPD_2IN13D_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        EPD_2IN13D_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    } while(busy);
+    EPD_2IN13D_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -231,31 +227,20 @@ static void EPD_2IN13D_SetFullReg(void)
     EPD_2IN13D_SendCommand(0X50);			//VCOM AND DATA INTERVAL SETTING
     EPD_2IN13D_SendData(0xb7);		//WBmode:VBDF 17|D7 VBDW 97 VBDB 57		WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
 
-    unsigned int count;
     EPD_2IN13D_SendCommand(0x20);
-    for(count=0; count<44; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_vcomDC[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_vcomDC, 44);
 
     EPD_2IN13D_SendCommand(0x21);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_ww[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_ww, 42);
 
     EPD_2IN13D_SendCommand(0x22);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_bw[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_bw, 42);
 
     EPD_2IN13D_SendCommand(0x23);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_wb[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_wb, 42);
 
     EPD_2IN13D_SendCommand(0x24);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_bb[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_bb, 42);
 }
 
 /******************************************************************************
@@ -269,31 +254,20 @@ static void EPD_2IN13D_SetPartReg(void)
     EPD_2IN13D_SendCommand(0X50);
     EPD_2IN13D_SendData(0xb7);
 	
-    unsigned int count;
     EPD_2IN13D_SendCommand(0x20);
-    for(count=0; count<44; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_vcom1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_vcom1, 44);
 
     EPD_2IN13D_SendCommand(0x21);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_ww1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_ww1, 42);
 
     EPD_2IN13D_SendCommand(0x22);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_bw1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_bw1, 42);
 
     EPD_2IN13D_SendCommand(0x23);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_wb1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_wb1, 42);
 
     EPD_2IN13D_SendCommand(0x24);
-    for(count=0; count<42; count++) {
-        EPD_2IN13D_SendData(EPD_2IN13D_lut_bb1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN13D_lut_bb1, 42);
 }
 
 /******************************************************************************
@@ -358,18 +332,10 @@ void EPD_2IN13D_Clear(void)
     Height = EPD_2IN13D_HEIGHT;
 
     EPD_2IN13D_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13D_SendData(0x00);
-        }
-    }
+    DEV_SPI_SendData_Fill(0x00, Height * Width);
 
     EPD_2IN13D_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13D_SendData(0xff);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xff, Height * Width);
 
     EPD_2IN13D_SetFullReg();
     EPD_2IN13D_TurnOnDisplay();
@@ -386,19 +352,11 @@ void EPD_2IN13D_Display(UBYTE *Image)
     Height = EPD_2IN13D_HEIGHT;
 
     EPD_2IN13D_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13D_SendData(0x00);
-        }
-    }
+    DEV_SPI_SendData_Fill(0x00, Height * Width);
     // Dev_Delay_ms(10);
 
     EPD_2IN13D_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13D_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     // Dev_Delay_ms(10);
 
 	EPD_2IN13D_SetFullReg();
@@ -429,18 +387,10 @@ void EPD_2IN13D_DisplayPart(UBYTE *Image)
     
     /* send data */
     EPD_2IN13D_SendCommand(0x10);
-    for (UWORD j = 0; j < EPD_2IN13D_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13D_SendData(~Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte_Inverted(Image, EPD_2IN13D_HEIGHT * Width);
 
     EPD_2IN13D_SendCommand(0x13);
-    for (UWORD j = 0; j < EPD_2IN13D_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN13D_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, EPD_2IN13D_HEIGHT * Width);
     EPD_2IN13D_SetPartReg();
     /* Set partial refresh */    
     EPD_2IN13D_TurnOnDisplay();
@@ -98,9 +98,7 @@ void EPD_2IN66_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
     DEV_Delay_ms(100);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(100);
     Debug("e-Paper busy release\r\n");
 }
@@ -123,11 +121,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN66_SetLUA(void)
 {
-    UWORD count;
     EPD_2IN66_SendCommand(0x32);
-    for(count=0;count<153;count++){
-        EPD_2IN66_SendData(WF_PARTIAL[count]);
-    }    
+    DEV_SPI_SendData_nByte(WF_PARTIAL, 153);    
     EPD_2IN66_ReadBusy();
 }
 
@@ -216,11 +211,7 @@ void EPD_2IN66_Clear(void)
     Width = (EPD_2IN66_WIDTH % 8 == 0)? (EPD_2IN66_WIDTH / 8 ): (EPD_2IN66_WIDTH / 8 + 1);
     Height = EPD_2IN66_HEIGHT;
     EPD_2IN66_SendCommand(0x24);
-    for (UWORD j = 0; j <=Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66_SendData(0xff);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xff, (Height + 1) * Width);
     EPD_2IN66_TurnOnDisplay();
 }
 
@@ -234,16 +225,10 @@ void EPD_2IN66_Display(UBYTE *Image)
     Width = (EPD_2IN66_WIDTH % 8 == 0)? (EPD_2IN66_WIDTH / 8 ): (EPD_2IN66_WIDTH / 8 + 1);
     Height = EPD_2IN66_HEIGHT;
 
-    UDOUBLE Addr = 0;
 	
     // UDOUBLE Offset = ImageName;
     EPD_2IN66_SendCommand(0x24);
-    for (UWORD j = 0; j <Height; j++) {
-        for (UWORD i = 0; i <Width; i++) {
-            Addr = i + j * Width;
-            EPD_2IN66_SendData(Image[Addr]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     EPD_2IN66_TurnOnDisplay();
 }
 
@@ -78,9 +78,7 @@ static void EPD_2IN66B_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
     DEV_Delay_ms(50);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(10);
-    }
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(50);
     Debug("e-Paper busy release\r\n");
 }
@@ -161,18 +159,10 @@ void EPD_2IN66B_Display(UBYTE *ImageBlack, UBYTE*ImageRed)
     Height = EPD_2IN66B_HEIGHT;
 
     EPD_2IN66B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(ImageBlack[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(ImageBlack, Height * Width);
 	
     EPD_2IN66B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(~ImageRed[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte_Inverted(ImageRed, Height * Width);
 
     EPD_2IN66B_TurnOnDisplay();
 }
@@ -188,17 +178,9 @@ void EPD_2IN66B_Clear(void)
     Height = EPD_2IN66B_HEIGHT;
 
     EPD_2IN66B_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(0xff);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xff, Height * Width);
 	EPD_2IN66B_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN66B_SendData(0x00);
-        }
-    }
+    DEV_SPI_SendData_Fill(0x00, Height * Width);
     EPD_2IN66B_TurnOnDisplay();
 }
 
@@ -179,12 +179,8 @@ parameter:
 static void EPD_2in7_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        EPD_2in7_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    } while(busy);
+    EPD_2in7_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -195,59 +191,41 @@ parameter:
 ******************************************************************************/
 static void EPD_2in7_SetLut(void)
 {
-    unsigned int count;
     EPD_2in7_SendCommand(0x20); //vcom
-    for(count = 0; count < 44; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_vcom_dc[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2in7_lut_vcom_dc, 44);
 
     EPD_2in7_SendCommand(0x21); //ww --
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_ww[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2in7_lut_ww, 42);
 
     EPD_2in7_SendCommand(0x22); //bw r
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_bw[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2in7_lut_bw, 42);
 
     EPD_2in7_SendCommand(0x23); //wb w
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_bb[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2in7_lut_bb, 42);
 
     EPD_2in7_SendCommand(0x24); //bb b
-    for(count = 0; count < 42; count++) {
-        EPD_2in7_SendData(EPD_2in7_lut_wb[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2in7_lut_wb, 42);
 }
 
 void EPD_2in7_gray_SetLut(void)
 {
-	unsigned int count;	 
     EPD_2in7_SendCommand(0x20);							//vcom
-		for(count=0;count<44;count++)
-			{EPD_2in7_SendData(EPD_2in7_gray_lut_vcom[count]);}
+		DEV_SPI_SendData_nByte(EPD_2in7_gray_lut_vcom, 44);
 		
 	EPD_2in7_SendCommand(0x21);							//red not use
-	for(count=0;count<42;count++)
-		{EPD_2in7_SendData(EPD_2in7_gray_lut_ww[count]);}
+	DEV_SPI_SendData_nByte(EPD_2in7_gray_lut_ww, 42);
 
 		EPD_2in7_SendCommand(0x22);							//bw r
-		for(count=0;count<42;count++)
-			{EPD_2in7_SendData(EPD_2in7_gray_lut_bw[count]);}
+		DEV_SPI_SendData_nByte(EPD_2in7_gray_lut_bw, 42);
 
 		EPD_2in7_SendCommand(0x23);							//wb w
-		for(count=0;count<42;count++)
-			{EPD_2in7_SendData(EPD_2in7_gray_lut_wb[count]);}
+		DEV_SPI_SendData_nByte(EPD_2in7_gray_lut_wb, 42);
 
 		EPD_2in7_SendCommand(0x24);							//bb b
-		for(count=0;count<42;count++)
-			{EPD_2in7_SendData(EPD_2in7_gray_lut_bb[count]);}
+		DEV_SPI_SendData_nByte(EPD_2in7_gray_lut_bb, 42);
 
 		EPD_2in7_SendCommand(0x25);							//vcom
-		for(count=0;count<42;count++)
-			{EPD_2in7_SendData(EPD_2in7_gray_lut_ww[count]);}
+		DEV_SPI_SendData_nByte(EPD_2in7_gray_lut_ww, 42);
          
 }
 
@@ -403,18 +381,10 @@ void EPD_2IN7_Clear(void)
     Height = EPD_2IN7_HEIGHT;
 
     EPD_2in7_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(0XFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);
 
     EPD_2in7_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(0XFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);
 		
     EPD_2in7_SendCommand(0x12);
     EPD_2in7_ReadBusy();
@@ -431,18 +401,10 @@ void EPD_2IN7_Display(const UBYTE *Image)
     Height = EPD_2IN7_HEIGHT;
 
     EPD_2in7_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(0XFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);
 
     EPD_2in7_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2in7_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     EPD_2in7_SendCommand(0x12);
     EPD_2in7_ReadBusy();
 }
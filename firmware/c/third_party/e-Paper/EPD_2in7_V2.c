@@ -101,10 +101,7 @@ parameter:
 static void EPD_2IN7_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    do {
-        if(DEV_Digital_Read(EPD_BUSY_PIN) == 0)
-			break;
-    } while(1);
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
 }
@@ -150,11 +147,8 @@ parameter:
 ******************************************************************************/
 static void EPD_2IN7_V2_Lut(void)
 {
-    unsigned int count;
     EPD_2IN7_V2_SendCommand(0x32); //vcom
-    for(count = 0; count < 153; count++) {
-        EPD_2IN7_V2_SendData(LUT_DATA_4Gray[count]);
-    }
+    DEV_SPI_SendData_nByte(LUT_DATA_4Gray, 153);
 }
 
 
@@ -295,11 +289,7 @@ void EPD_2IN7_V2_Clear(void)
     Height = EPD_2IN7_V2_HEIGHT;
 
     EPD_2IN7_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(0XFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0XFF, Height * Width);
 
 	EPD_2IN7_V2_TurnOnDisplay();
 }
@@ -315,11 +305,7 @@ void EPD_2IN7_V2_Display(UBYTE *Image)
     Height = EPD_2IN7_V2_HEIGHT;
 	
     EPD_2IN7_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	
 	EPD_2IN7_V2_TurnOnDisplay();
 }
@@ -331,11 +317,7 @@ void EPD_2IN7_V2_Display_Fast(const UBYTE *Image)
     Height = EPD_2IN7_V2_HEIGHT;
 	
     EPD_2IN7_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2IN7_V2_TurnOnDisplay_Fast();
 }
 
@@ -346,17 +328,9 @@ void EPD_2IN7_V2_Display_Base(UBYTE *Image)
     Height = EPD_2IN7_V2_HEIGHT;
 
 	EPD_2IN7_V2_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2IN7_V2_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 	EPD_2IN7_V2_TurnOnDisplay();	
 }
 
@@ -367,17 +341,9 @@ void EPD_2IN7_V2_Display_Base_color(UBYTE color)
     Height = EPD_2IN7_V2_HEIGHT;
 
 	EPD_2IN7_V2_SendCommand(0x24);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(color);
-        }
-    }
+    DEV_SPI_SendData_Fill(color, Height * Width);
 	EPD_2IN7_V2_SendCommand(0x26);   //Write Black and White image to RAM
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN7_V2_SendData(color);
-        }
-    }
+    DEV_SPI_SendData_Fill(color, Height * Width);
 	// EPD_2IN7_V2_TurnOnDisplay();	
 }
 
@@ -395,7 +361,7 @@ void EPD_2IN7_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
     }
     
 
-    UWORD i, Width;
+    UWORD Width;
 	Width = Xend -  Xstart;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -424,9 +390,7 @@ void EPD_2IN7_V2_Display_Partial(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
 
 
     EPD_2IN7_V2_SendCommand(0x24);   //Write Black and White image to RAM
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-	    EPD_2IN7_V2_SendData(Image[i]);
-	}
+    DEV_SPI_SendData_nByte(Image, IMAGE_COUNTER);
 	EPD_2IN7_V2_TurnOnDisplay_Partial();
 }
 
@@ -143,26 +143,22 @@ static void EPD_2IN9_V2_SendData(UBYTE Data)
 /******************************************************************************
 function :	Wait until the busy_pin goes LOW
 parameter:
+Info:
+	Returns 0 when idle, 1 on BUSY timeout
 ******************************************************************************/
-void EPD_2IN9_V2_ReadBusy(void)
+UBYTE EPD_2IN9_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	while(1)
-	{	 //=1 BUSY
-		if(DEV_Digital_Read(EPD_BUSY_PIN)==0) 
-			break;
-		DEV_Delay_ms(50);
-	}
-	DEV_Delay_ms(50);
+    UBYTE timed_out = DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(50);
     Debug("e-Paper busy release\r\n");
+    return timed_out;
 }
 
 static void EPD_2IN9_V2_LUT(UBYTE *lut)
 {
-	UBYTE count;
 	EPD_2IN9_V2_SendCommand(0x32);
-	for(count=0; count<153; count++) 
-		EPD_2IN9_V2_SendData(lut[count]); 
+	DEV_SPI_SendData_nByte(lut, 153); 
 	EPD_2IN9_V2_ReadBusy();
 }
 
@@ -186,12 +182,12 @@ static void EPD_2IN9_V2_LUT_by_host(UBYTE *lut)
 function :	Turn On Display
 parameter:
 ******************************************************************************/
-static void EPD_2IN9_V2_TurnOnDisplay(void)
+static UBYTE EPD_2IN9_V2_TurnOnDisplay(void)
 {
 	EPD_2IN9_V2_SendCommand(0x22); //Display Update Control
 	EPD_2IN9_V2_SendData(0xc7);
 	EPD_2IN9_V2_SendCommand(0x20); //Activate Display Update Sequence
-	EPD_2IN9_V2_ReadBusy();
+	return EPD_2IN9_V2_ReadBusy();
 }
 
 static void EPD_2IN9_V2_TurnOnDisplay_Partial(void)
@@ -298,53 +294,36 @@ void EPD_2IN9_V2_Gray4_Init(void)
 function :	Clear screen
 parameter:
 ******************************************************************************/
-void EPD_2IN9_V2_Clear(void)
+UBYTE EPD_2IN9_V2_Clear(void)
 {
-	UWORD i;
 	
 	EPD_2IN9_V2_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(0xff);
-	}
+	DEV_SPI_SendData_Fill(0xff, 4736);
 
 	EPD_2IN9_V2_SendCommand(0x26);   //write RAM for black(0)/white (1)
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(0xff);
-	}
-	EPD_2IN9_V2_TurnOnDisplay();
+	DEV_SPI_SendData_Fill(0xff, 4736);
+	return EPD_2IN9_V2_TurnOnDisplay();
 }
 
 /******************************************************************************
 function :	Sends the image buffer in RAM to e-Paper and displays
 parameter:
 ******************************************************************************/
-void EPD_2IN9_V2_Display(UBYTE *Image)
+UBYTE EPD_2IN9_V2_Display(UBYTE *Image)
 {
-	UWORD i;	
-	EPD_2IN9_V2_SendCommand(0x24);   //write RAM for black(0)/white (1)
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(Image[i]);
-	}
-	EPD_2IN9_V2_TurnOnDisplay();	
+	DEV_SPI_Plane plane = { 0x24, Image, 4736, 1, 4736, false };   //write RAM for black(0)/white (1)
+	DEV_SPI_Stream(&plane, 1);
+	return EPD_2IN9_V2_TurnOnDisplay();
 }
 
 void EPD_2IN9_V2_Display_Base(UBYTE *Image)
 {
-	UWORD i;   
 
-	EPD_2IN9_V2_SendCommand(0x24);   //Write Black and White image to RAM
-	for(i=0;i<4736;i++)
-	{               
-		EPD_2IN9_V2_SendData(Image[i]);
-	}
-	EPD_2IN9_V2_SendCommand(0x26);   //Write Black and White image to RAM
-	for(i=0;i<4736;i++)
-	{               
-		EPD_2IN9_V2_SendData(Image[i]);
-	}
+	DEV_SPI_Plane planes[2] = {
+		{ 0x24, Image, 4736, 1, 4736, false },   //Write Black and White image to RAM
+		{ 0x26, Image, 4736, 1, 4736, false },
+	};
+	DEV_SPI_Stream(planes, 2);
 	EPD_2IN9_V2_TurnOnDisplay();	
 }
 
@@ -433,7 +412,6 @@ void EPD_2IN9_V2_4GrayDisplay(UBYTE *Image)
 
 void EPD_2IN9_V2_Display_Partial(UBYTE *Image)
 {
-	UWORD i;
 
 //Reset
     DEV_Digital_Write(EPD_RST_PIN, 0);
@@ -466,10 +444,7 @@ void EPD_2IN9_V2_Display_Partial(UBYTE *Image)
 	EPD_2IN9_V2_SetCursor(0, 0);
 
 	EPD_2IN9_V2_SendCommand(0x24);   //Write Black and White image to RAM
-	for(i=0;i<4736;i++)
-	{
-		EPD_2IN9_V2_SendData(Image[i]);
-	} 
+	DEV_SPI_SendData_nByte(Image, 4736); 
 	EPD_2IN9_V2_TurnOnDisplay_Partial();
 }
 
@@ -39,8 +39,8 @@
 
 void EPD_2IN9_V2_Init(void);
 void EPD_2IN9_V2_Gray4_Init(void);
-void EPD_2IN9_V2_Clear(void);
-void EPD_2IN9_V2_Display(UBYTE *Image);
+UBYTE EPD_2IN9_V2_Clear(void);
+UBYTE EPD_2IN9_V2_Display(UBYTE *Image);
 void EPD_2IN9_V2_Display_Base(UBYTE *Image);
 void EPD_2IN9_V2_4GrayDisplay(UBYTE *Image);
 void EPD_2IN9_V2_Display_Partial(UBYTE *Image);
@@ -131,9 +131,7 @@ parameter:
 void EPD_2IN9BC_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(100);
-    }
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -179,19 +177,11 @@ void EPD_2IN9BC_Clear(void)
 
     //send black data
     EPD_2IN9BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     //send red data
     EPD_2IN9BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 		
 		EPD_2IN9BC_SendCommand(0x12);
 		EPD_2IN9BC_ReadBusy();
@@ -208,19 +198,11 @@ void EPD_2IN9BC_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_2IN9BC_HEIGHT;
 
     EPD_2IN9BC_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(blackimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(blackimage, Height * Width);
     EPD_2IN9BC_SendCommand(0x92);
     
     EPD_2IN9BC_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9BC_SendData(ryimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(ryimage, Height * Width);
     EPD_2IN9BC_SendCommand(0x92);
 
     EPD_2IN9BC_SendCommand(0x12);
@@ -203,12 +203,8 @@ parameter:
 void EPD_2IN9D_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        EPD_2IN9D_SendCommand(0x71);
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-        busy =!(busy & 0x01);
-    } while(busy);
+    EPD_2IN9D_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -222,31 +218,20 @@ static void EPD_SetFullReg(void)
     EPD_2IN9D_SendCommand(0X50);			//VCOM AND DATA INTERVAL SETTING
     EPD_2IN9D_SendData(0xb7);		//WBmode:VBDF 17|D7 VBDW 97 VBDB 57		WBRmode:VBDF F7 VBDW 77 VBDB 37  VBDR B7
 
-    unsigned int count;
     EPD_2IN9D_SendCommand(0x20);
-    for(count=0; count<44; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_vcomDC[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_vcomDC, 44);
 
     EPD_2IN9D_SendCommand(0x21);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_ww[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_ww, 42);
 
     EPD_2IN9D_SendCommand(0x22);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_bw[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_bw, 42);
 
     EPD_2IN9D_SendCommand(0x23);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_wb[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_wb, 42);
 
     EPD_2IN9D_SendCommand(0x24);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_bb[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_bb, 42);
 }
 
 /******************************************************************************
@@ -260,31 +245,20 @@ static void EPD_2IN9D_SetPartReg(void)
     EPD_2IN9D_SendCommand(0X50);
     EPD_2IN9D_SendData(0xb7);
 	
-    unsigned int count;
     EPD_2IN9D_SendCommand(0x20);
-    for(count=0; count<44; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_vcom1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_vcom1, 44);
 
     EPD_2IN9D_SendCommand(0x21);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_ww1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_ww1, 42);
 
     EPD_2IN9D_SendCommand(0x22);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_bw1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_bw1, 42);
 
     EPD_2IN9D_SendCommand(0x23);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_wb1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_wb1, 42);
 
     EPD_2IN9D_SendCommand(0x24);
-    for(count=0; count<42; count++) {
-        EPD_2IN9D_SendData(EPD_2IN9D_lut_bb1[count]);
-    }
+    DEV_SPI_SendData_nByte(EPD_2IN9D_lut_bb1, 42);
 }
 
 /******************************************************************************
@@ -349,18 +323,10 @@ void EPD_2IN9D_Clear(void)
     Height = EPD_2IN9D_HEIGHT;
 
     EPD_2IN9D_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9D_SendData(0x00);
-        }
-    }
+    DEV_SPI_SendData_Fill(0x00, Height * Width);
 
     EPD_2IN9D_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9D_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     EPD_SetFullReg();
     EPD_2IN9D_TurnOnDisplay();
@@ -377,19 +343,11 @@ void EPD_2IN9D_Display(UBYTE *Image)
     Height = EPD_2IN9D_HEIGHT;
 
     EPD_2IN9D_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9D_SendData(0x00);
-        }
-    }
+    DEV_SPI_SendData_Fill(0x00, Height * Width);
     // Dev_Delay_ms(10);
 
     EPD_2IN9D_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9D_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
     // Dev_Delay_ms(10);
 
     EPD_SetFullReg();
@@ -420,11 +378,7 @@ void EPD_2IN9D_DisplayPart(UBYTE *Image)
     
     /* send data */
     EPD_2IN9D_SendCommand(0x13);
-    for (UWORD j = 0; j < EPD_2IN9D_HEIGHT; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_2IN9D_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, EPD_2IN9D_HEIGHT * Width);
 
     /* Set partial refresh */    
     EPD_2IN9D_TurnOnDisplay();
@@ -134,10 +134,7 @@ static void EPD_3IN7_SendData(UBYTE Data)
 static void EPD_3IN7_ReadBusy_HIGH(void)
 {
     Debug("e-Paper busy\r\n");
-    UBYTE busy;
-    do {
-        busy = DEV_Digital_Read(EPD_BUSY_PIN);
-    } while(busy);
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
     DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
@@ -341,11 +338,7 @@ void EPD_3IN7_4Gray_Clear(void)
     EPD_3IN7_SendData(0x00);
     
     EPD_3IN7_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-       for (UWORD i = 0; i < Width; i++) {
-           EPD_3IN7_SendData(0xff);
-       }
-    }
+    DEV_SPI_SendData_Fill(0xff, Height * Width);
     
     EPD_3IN7_SendCommand(0x4E);
     EPD_3IN7_SendData(0x00);
@@ -356,11 +349,7 @@ void EPD_3IN7_4Gray_Clear(void)
     EPD_3IN7_SendData(0x00);
     
     EPD_3IN7_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-       for (UWORD i = 0; i < Width; i++) {
-           EPD_3IN7_SendData(0xff);
-       }
-    }
+    DEV_SPI_SendData_Fill(0xff, Height * Width);
       
     EPD_3IN7_Load_LUT(0);
     EPD_3IN7_SendCommand(0x22);
@@ -376,7 +365,6 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_1Gray_Clear(void)
 {
-  UWORD i;
   UWORD IMAGE_COUNTER = EPD_3IN7_WIDTH * EPD_3IN7_HEIGHT / 8;
 
   EPD_3IN7_SendCommand(0x4E);
@@ -387,10 +375,7 @@ void EPD_3IN7_1Gray_Clear(void)
   EPD_3IN7_SendData(0x00);
 
   EPD_3IN7_SendCommand(0x24);
-  for (i = 0; i < IMAGE_COUNTER; i++)
-  {
-    EPD_3IN7_SendData(0xff);
-  }
+  DEV_SPI_SendData_Fill(0xff, IMAGE_COUNTER);
   
   EPD_3IN7_Load_LUT(2);
   
@@ -518,7 +503,6 @@ parameter:
 ******************************************************************************/
 void EPD_3IN7_1Gray_Display(const UBYTE *Image)
 {
-  UWORD i;
   UWORD IMAGE_COUNTER = EPD_3IN7_WIDTH * EPD_3IN7_HEIGHT / 8;
 
   EPD_3IN7_SendCommand(0x4E);
@@ -529,10 +513,7 @@ void EPD_3IN7_1Gray_Display(const UBYTE *Image)
   EPD_3IN7_SendData(0x00);
 
   EPD_3IN7_SendCommand(0x24);
-  for (i = 0; i < IMAGE_COUNTER; i++)
-  {
-    EPD_3IN7_SendData(Image[i]);
-  }
+  DEV_SPI_SendData_nByte(Image, IMAGE_COUNTER);
 
   EPD_3IN7_Load_LUT(2);
   EPD_3IN7_SendCommand(0x20);
@@ -548,7 +529,7 @@ notes:
 ******************************************************************************/
 void EPD_3IN7_1Gray_Display_Part(const UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
 {
-	UWORD i, Width;
+	UWORD Width;
 	Width = (Xend-Xstart)%8 == 0 ? (Xend-Xstart)/8 : (Xend-Xstart)/8+1;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -574,10 +555,7 @@ void EPD_3IN7_1Gray_Display_Part(const UBYTE *Image, UWORD Xstart, UWORD Ystart,
     EPD_3IN7_SendData((Ystart >> 8) & 0xFF);
 	
 	EPD_3IN7_SendCommand(0x24);
-	for (i = 0; i < IMAGE_COUNTER; i++)
-	{
-	EPD_3IN7_SendData(Image[i]);
-	}
+	DEV_SPI_SendData_nByte(Image, IMAGE_COUNTER);
 
 	EPD_3IN7_Load_LUT(3);
 	EPD_3IN7_SendCommand(0x20);
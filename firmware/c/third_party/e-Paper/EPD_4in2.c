@@ -326,11 +326,8 @@ parameter:
 void EPD_4IN2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-	EPD_4IN2_SendCommand(0x71);
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 0) {      //LOW: idle, HIGH: busy
-		EPD_4IN2_SendCommand(0x71);
-        DEV_Delay_ms(100);
-    }
+    EPD_4IN2_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -351,80 +348,61 @@ parameter:
 ******************************************************************************/
 static void EPD_4IN2_Partial_SetLut(void)
 {
-	unsigned int count;
 	EPD_4IN2_SendCommand(0x20);
-	for(count=0;count<44;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_vcom1[count]);}
+	DEV_SPI_SendData_nByte(EPD_4IN2_Partial_lut_vcom1, 44);
 
 	EPD_4IN2_SendCommand(0x21);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_ww1[count]);}   
+	DEV_SPI_SendData_nByte(EPD_4IN2_Partial_lut_ww1, 42);   
 	
 	EPD_4IN2_SendCommand(0x22);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_bw1[count]);} 
+	DEV_SPI_SendData_nByte(EPD_4IN2_Partial_lut_bw1, 42); 
 
 	EPD_4IN2_SendCommand(0x23);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_wb1[count]);} 
+	DEV_SPI_SendData_nByte(EPD_4IN2_Partial_lut_wb1, 42); 
 
 	EPD_4IN2_SendCommand(0x24);
-	for(count=0;count<42;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_Partial_lut_bb1[count]);} 
+	DEV_SPI_SendData_nByte(EPD_4IN2_Partial_lut_bb1, 42); 
 }
 
 static void EPD_4IN2_SetLut(void)
 {
-	unsigned int count;
 	EPD_4IN2_SendCommand(0x20);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_vcom0[count]);}
+	DEV_SPI_SendData_nByte(EPD_4IN2_lut_vcom0, 36);
 
 	EPD_4IN2_SendCommand(0x21);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_ww[count]);}   
+	DEV_SPI_SendData_nByte(EPD_4IN2_lut_ww, 36);   
 	
 	EPD_4IN2_SendCommand(0x22);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_bw[count]);} 
+	DEV_SPI_SendData_nByte(EPD_4IN2_lut_bw, 36); 
 
 	EPD_4IN2_SendCommand(0x23);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_wb[count]);} 
+	DEV_SPI_SendData_nByte(EPD_4IN2_lut_wb, 36); 
 
 	EPD_4IN2_SendCommand(0x24);
-	for(count=0;count<36;count++)	     
-		{EPD_4IN2_SendData(EPD_4IN2_lut_bb[count]);}   
+	DEV_SPI_SendData_nByte(EPD_4IN2_lut_bb, 36);   
 }
 
 //LUT download
 static void EPD_4IN2_4Gray_lut(void)
 {
-	unsigned int count;	 
 	{
 		EPD_4IN2_SendCommand(0x20);							//vcom
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_vcom[count]);}
+		DEV_SPI_SendData_nByte(EPD_4IN2_4Gray_lut_vcom, 42);
 		
 	EPD_4IN2_SendCommand(0x21);							//red not use
-	for(count=0;count<42;count++)
-		{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_ww[count]);}
+	DEV_SPI_SendData_nByte(EPD_4IN2_4Gray_lut_ww, 42);
 
 		EPD_4IN2_SendCommand(0x22);							//bw r
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_bw[count]);}
+		DEV_SPI_SendData_nByte(EPD_4IN2_4Gray_lut_bw, 42);
 
 		EPD_4IN2_SendCommand(0x23);							//wb w
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_wb[count]);}
+		DEV_SPI_SendData_nByte(EPD_4IN2_4Gray_lut_wb, 42);
 
 		EPD_4IN2_SendCommand(0x24);							//bb b
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_bb[count]);}
+		DEV_SPI_SendData_nByte(EPD_4IN2_4Gray_lut_bb, 42);
 
 		EPD_4IN2_SendCommand(0x25);							//vcom
-		for(count=0;count<42;count++)
-			{EPD_4IN2_SendData(EPD_4IN2_4Gray_lut_ww[count]);}
+		DEV_SPI_SendData_nByte(EPD_4IN2_4Gray_lut_ww, 42);
 	}	         
 }
 /******************************************************************************
@@ -560,18 +538,10 @@ void EPD_4IN2_Clear(void)
     Height = EPD_4IN2_HEIGHT;
 
     EPD_4IN2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     EPD_4IN2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
 	EPD_4IN2_SendCommand(0x12);		 //DISPLAY REFRESH 		
 	DEV_Delay_ms(1);	
@@ -589,18 +559,10 @@ void EPD_4IN2_Display(UBYTE *Image)
     Height = EPD_4IN2_HEIGHT;
 
 	EPD_4IN2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(0x00);
-        }
-    }
+    DEV_SPI_SendData_Fill(0x00, Height * Width);
 
     EPD_4IN2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_SendData(Image[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(Image, Height * Width);
 
 	EPD_4IN2_SendCommand(0x12);		 //DISPLAY REFRESH 		
 	DEV_Delay_ms(10);		
@@ -636,14 +598,12 @@ void EPD_4IN2_PartialDisplay(UWORD X_start,UWORD Y_start,UWORD X_end,UWORD Y_end
 
 	EPD_4IN2_SendCommand(0x10);	       //writes Old data to SRAM for programming
     for (UWORD j = 0; j < Y_end - Y_start; j++) {
-        for (UWORD i = 0; i < (X_end - X_start)/8; i++) {
-            EPD_4IN2_SendData(DATA[(Y_start + j)*Width + X_start/8 + i]);
-        }
+        DEV_SPI_SendData_nByte(DATA + (Y_start + j)*Width + X_start/8, (X_end - X_start)/8);
     }
 	EPD_4IN2_SendCommand(0x13);				 //writes New data to SRAM.
     for (UWORD j = 0; j < Y_end - Y_start; j++) {
+        DEV_SPI_SendData_nByte_Inverted(Image + (Y_start + j)*Width + X_start/8, (X_end - X_start)/8);
         for (UWORD i = 0; i < (X_end - X_start)/8; i++) {
-            EPD_4IN2_SendData(~Image[(Y_start + j)*Width + X_start/8 + i]);
 			DATA[(Y_start + j)*Width + X_start/8 + i] = ~Image[(Y_start + j)*Width + X_start/8 + i];
         }
     }
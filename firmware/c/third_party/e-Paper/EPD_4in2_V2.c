@@ -111,42 +111,43 @@ static void EPD_4IN2_V2_SendData(UBYTE Data)
 /******************************************************************************
 function :	Wait until the busy_pin goes LOW
 parameter:
+Info:
+	Returns 0 when idle, 1 on BUSY timeout
 ******************************************************************************/
-void EPD_4IN2_V2_ReadBusy(void)
+UBYTE EPD_4IN2_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    while(DEV_Digital_Read(EPD_BUSY_PIN) == 1) {      //LOW: idle, HIGH: busy
-        DEV_Delay_ms(10);
-    }
+    UBYTE timed_out = DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
+    return timed_out;
 }
 
 /******************************************************************************
 function :	Turn On Display
 parameter:
 ******************************************************************************/
-static void EPD_4IN2_V2_TurnOnDisplay(void)
+static UBYTE EPD_4IN2_V2_TurnOnDisplay(void)
 {
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xF7);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    return EPD_4IN2_V2_ReadBusy();
 }
 
-static void EPD_4IN2_V2_TurnOnDisplay_Fast(void)
+static UBYTE EPD_4IN2_V2_TurnOnDisplay_Fast(void)
 {
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xC7);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    return EPD_4IN2_V2_ReadBusy();
 }
 
-static void EPD_4IN2_V2_TurnOnDisplay_Partial(void)
+static UBYTE EPD_4IN2_V2_TurnOnDisplay_Partial(void)
 {
     EPD_4IN2_V2_SendCommand(0x22);
 	EPD_4IN2_V2_SendData(0xFF);
     EPD_4IN2_V2_SendCommand(0x20);
-    EPD_4IN2_V2_ReadBusy();
+    return EPD_4IN2_V2_ReadBusy();
 }
 
 static void EPD_4IN2_V2_TurnOnDisplay_4Gray(void)
@@ -191,14 +192,11 @@ static void EPD_4IN2_V2_SetCursor(UWORD Xstart, UWORD Ystart)
 //LUT download
 static void EPD_4IN2_V2_4Gray_lut(void)
 {
-    unsigned char i;
+    unsigned char i = 227;
 
     //WS byte 0~152, the content of VS[nX-LUTm], TP[nX], RP[n], SR[nXY], FR[n] and XON[nXY]
     EPD_4IN2_V2_SendCommand(0x32);					
-    for(i=0;i<227;i++)
-    {
-        EPD_4IN2_V2_SendData(LUT_ALL[i]);
-    }	
+    DEV_SPI_SendData_nByte(LUT_ALL, 227);	
     //WS byte 153, the content of Option for LUT end	
     EPD_4IN2_V2_SendCommand(0x3F);					
     EPD_4IN2_V2_SendData(LUT_ALL[i++]);
@@ -327,78 +325,54 @@ void EPD_4IN2_V2_Init_4Gray(void)
 function :	Clear screen
 parameter:
 ******************************************************************************/
-void EPD_4IN2_V2_Clear(void)
+UBYTE EPD_4IN2_V2_Clear(void)
 {
     UWORD Width, Height;
     Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
     Height = EPD_4IN2_V2_HEIGHT;
 
     EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(0xFF);
-        }
-    }
-    EPD_4IN2_V2_TurnOnDisplay();
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
+    return EPD_4IN2_V2_TurnOnDisplay();
 }
 
 /******************************************************************************
 function :	Sends the image buffer in RAM to e-Paper and displays
 parameter:
 ******************************************************************************/
-void EPD_4IN2_V2_Display(UBYTE *Image)
+UBYTE EPD_4IN2_V2_Display(UBYTE *Image)
 {
     UWORD Width, Height;
     Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
     Height = EPD_4IN2_V2_HEIGHT;
 
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-    EPD_4IN2_V2_TurnOnDisplay();
+    DEV_SPI_Plane planes[2] = {
+        { 0x24, Image, Width, Height, Width, false },
+        { 0x26, Image, Width, Height, Width, false },
+    };
+    DEV_SPI_Stream(planes, 2);
+    return EPD_4IN2_V2_TurnOnDisplay();
 }
 
 /******************************************************************************
 function :	Sends the image buffer in RAM to e-Paper and fast displays
 parameter:
 ******************************************************************************/
-void EPD_4IN2_V2_Display_Fast(UBYTE *Image)
+UBYTE EPD_4IN2_V2_Display_Fast(UBYTE *Image)
 {
     UWORD Width, Height;
     Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
     Height = EPD_4IN2_V2_HEIGHT;
 
-    EPD_4IN2_V2_SendCommand(0x24);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-
-    EPD_4IN2_V2_SendCommand(0x26);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2_V2_SendData(Image[i + j * Width]);
-        }
-    }
-    EPD_4IN2_V2_TurnOnDisplay_Fast();
+    DEV_SPI_Plane planes[2] = {
+        { 0x24, Image, Width, Height, Width, false },
+        { 0x26, Image, Width, Height, Width, false },
+    };
+    DEV_SPI_Stream(planes, 2);
+    return EPD_4IN2_V2_TurnOnDisplay_Fast();
 }
 
 
@@ -512,7 +486,7 @@ void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD
 	}
 
 
-	UWORD i, Width;
+	UWORD Width;
 	Width = Xend -  Xstart;
 	UWORD IMAGE_COUNTER = Width * (Yend-Ystart);
 
@@ -545,13 +519,83 @@ void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD
 	EPD_4IN2_V2_SendData((Ystart>>8) & 0x01);
 	
     EPD_4IN2_V2_SendCommand(0x24);
-    for (i = 0; i < IMAGE_COUNTER; i++) {
-		EPD_4IN2_V2_SendData(Image[i]);
-	}
+    DEV_SPI_SendData_nByte(Image, IMAGE_COUNTER);
 	
 	EPD_4IN2_V2_TurnOnDisplay_Partial();
 }
 
+/******************************************************************************
+function :	Load a base image into both RAM planes (new and old data) without
+			refreshing the panel. Restores the controller state after a power
+			cycle, so that a following partial refresh only drives changed pixels.
+parameter:
+	Image :	Full frame that is currently shown on the panel
+******************************************************************************/
+void EPD_4IN2_V2_Load_Base(UBYTE *Image)
+{
+    UWORD Width, Height;
+    Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
+    Height = EPD_4IN2_V2_HEIGHT;
+
+    EPD_4IN2_V2_SetWindows(0, 0, EPD_4IN2_V2_WIDTH-1, EPD_4IN2_V2_HEIGHT-1);
+    EPD_4IN2_V2_SetCursor(0, 0);
+    DEV_SPI_Plane plane = { 0x24, Image, Width, Height, Width, false };
+    DEV_SPI_Stream(&plane, 1);
+
+    EPD_4IN2_V2_SetCursor(0, 0);
+    plane.Command = 0x26;
+    DEV_SPI_Stream(&plane, 1);
+}
+
+/******************************************************************************
+function :	Write one window of a full frame into the new data RAM (0x24),
+			without refreshing. Several windows can be written before a
+			single EPD_4IN2_V2_PartialRefresh().
+parameter:
+	Image :	Full frame buffer (not only the window)
+	Xstart:	Left edge in pixels, multiple of 8
+	Ystart:	Top edge in pixels
+	Xend  :	Right edge in pixels (exclusive), multiple of 8
+	Yend  :	Bottom edge in pixels (exclusive)
+******************************************************************************/
+void EPD_4IN2_V2_PartialWindow(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend)
+{
+    UWORD Width = (EPD_4IN2_V2_WIDTH % 8 == 0)? (EPD_4IN2_V2_WIDTH / 8 ): (EPD_4IN2_V2_WIDTH / 8 + 1);
+    UWORD Xbyte_start = Xstart / 8;
+    UWORD Xbyte_end = (Xend + 7) / 8;
+
+    if(Xbyte_end > Width)
+        Xbyte_end = Width;
+    if(Yend > EPD_4IN2_V2_HEIGHT)
+        Yend = EPD_4IN2_V2_HEIGHT;
+    if(Xbyte_start >= Xbyte_end || Ystart >= Yend)
+        return;
+
+    EPD_4IN2_V2_SetWindows(Xbyte_start * 8, Ystart, (Xbyte_end * 8) - 1, Yend - 1);
+    EPD_4IN2_V2_SetCursor(Xbyte_start, Ystart);
+
+    // Rows are read in place from the full frame
+    DEV_SPI_Plane plane = { 0x24, Image + Xbyte_start + Ystart * Width, Xbyte_end - Xbyte_start, Yend - Ystart, Width, false };
+    DEV_SPI_Stream(&plane, 1);
+}
+
+/******************************************************************************
+function :	Partial refresh of the panel using the data written with
+			EPD_4IN2_V2_Load_Base() / EPD_4IN2_V2_PartialWindow()
+parameter:
+******************************************************************************/
+UBYTE EPD_4IN2_V2_PartialRefresh(void)
+{
+	EPD_4IN2_V2_SendCommand(0x3C); //BorderWavefrom
+	EPD_4IN2_V2_SendData(0x80);
+
+	EPD_4IN2_V2_SendCommand(0x21); // Display update control: compare new against old RAM
+	EPD_4IN2_V2_SendData(0x00);
+	EPD_4IN2_V2_SendData(0x00);
+
+	return EPD_4IN2_V2_TurnOnDisplay_Partial();
+}
+
 /******************************************************************************
 function :	Enter sleep mode
 parameter:
@@ -46,11 +46,14 @@
 void EPD_4IN2_V2_Init(void);
 void EPD_4IN2_V2_Init_Fast(UBYTE Mode);
 void EPD_4IN2_V2_Init_4Gray(void);
-void EPD_4IN2_V2_Clear(void);
-void EPD_4IN2_V2_Display(UBYTE *Image);
-void EPD_4IN2_V2_Display_Fast(UBYTE *Image);
+UBYTE EPD_4IN2_V2_Clear(void);
+UBYTE EPD_4IN2_V2_Display(UBYTE *Image);
+UBYTE EPD_4IN2_V2_Display_Fast(UBYTE *Image);
 void EPD_4IN2_V2_Display_4Gray(UBYTE *Image);
 void EPD_4IN2_V2_PartialDisplay(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+void EPD_4IN2_V2_Load_Base(UBYTE *Image);
+void EPD_4IN2_V2_PartialWindow(UBYTE *Image, UWORD Xstart, UWORD Ystart, UWORD Xend, UWORD Yend);
+UBYTE EPD_4IN2_V2_PartialRefresh(void);
 void EPD_4IN2_V2_Sleep(void);
 
 #endif
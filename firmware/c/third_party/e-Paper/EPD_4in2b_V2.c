@@ -78,12 +78,8 @@ parameter:
 void EPD_4IN2B_V2_ReadBusy(void)
 {
     Debug("e-Paper busy\r\n");
-    unsigned char busy;
-    do{
-        EPD_4IN2B_V2_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01); 
-    }while(busy);
+    EPD_4IN2B_V2_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
     Debug("e-Paper busy release\r\n");
     DEV_Delay_ms(200);
 }
@@ -125,18 +121,10 @@ void EPD_4IN2B_V2_Clear(void)
     Height = EPD_4IN2B_V2_HEIGHT;
 
     EPD_4IN2B_V2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     EPD_4IN2B_V2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(0xFF);
-        }
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height * Width);
 
     EPD_4IN2B_V2_TurnOnDisplay();
 }
@@ -152,18 +140,10 @@ void EPD_4IN2B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_4IN2B_V2_HEIGHT;
 
     EPD_4IN2B_V2_SendCommand(0x10);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(blackimage, Height * Width);
 
     EPD_4IN2B_V2_SendCommand(0x13);
-    for (UWORD j = 0; j < Height; j++) {
-        for (UWORD i = 0; i < Width; i++) {
-            EPD_4IN2B_V2_SendData(ryimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(ryimage, Height * Width);
 
     EPD_4IN2B_V2_TurnOnDisplay();
 }
@@ -73,12 +73,12 @@ static void EPD_5IN65F_SendData(UBYTE Data)
 
 static void EPD_5IN65F_BusyHigh(void)// If BUSYN=0 then waiting
 {
-    while(!(DEV_Digital_Read(EPD_BUSY_PIN)));
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
 }
 
 static void EPD_5IN65F_BusyLow(void)// If BUSYN=1 then waiting
 {
-    while(DEV_Digital_Read(EPD_BUSY_PIN));
+    DEV_Wait_Busy(0, DEV_BUSY_TIMEOUT_MS);
 }
 
 /******************************************************************************
@@ -136,10 +136,7 @@ void EPD_5IN65F_Clear(UBYTE color)
     EPD_5IN65F_SendData(0x01);
     EPD_5IN65F_SendData(0xC0);
     EPD_5IN65F_SendCommand(0x10);
-    for(int i=0; i<EPD_5IN65F_WIDTH/2; i++) {
-        for(int j=0; j<EPD_5IN65F_HEIGHT; j++)
-            EPD_5IN65F_SendData((color<<4)|color);
-    }
+    DEV_SPI_SendData_Fill((color<<4)|color, EPD_5IN65F_WIDTH/2 * EPD_5IN65F_HEIGHT);
     EPD_5IN65F_SendCommand(0x04);//0x04
     EPD_5IN65F_BusyHigh();
     EPD_5IN65F_SendCommand(0x12);//0x12
@@ -155,17 +152,13 @@ parameter:
 ******************************************************************************/
 void EPD_5IN65F_Display(const UBYTE *image)
 {
-    unsigned long i,j;
     EPD_5IN65F_SendCommand(0x61);//Set Resolution setting
     EPD_5IN65F_SendData(0x02);
     EPD_5IN65F_SendData(0x58);
     EPD_5IN65F_SendData(0x01);
     EPD_5IN65F_SendData(0xC0);
     EPD_5IN65F_SendCommand(0x10);
-    for(i=0; i<EPD_5IN65F_HEIGHT; i++) {
-        for(j=0; j<EPD_5IN65F_WIDTH/2; j++)
-            EPD_5IN65F_SendData(image[j+((EPD_5IN65F_WIDTH/2)*i)]);
-    }
+    DEV_SPI_SendData_nByte(image, EPD_5IN65F_HEIGHT * EPD_5IN65F_WIDTH/2);
     EPD_5IN65F_SendCommand(0x04);//0x04
     EPD_5IN65F_BusyHigh();
     EPD_5IN65F_SendCommand(0x12);//0x12
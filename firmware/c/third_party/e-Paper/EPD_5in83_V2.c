@@ -77,13 +77,11 @@ parameter:
 ******************************************************************************/
 static void EPD_5in83_V2_ReadBusy(void)
 {
-	Debug("e-Paper busy\r\n");
-	do {
-		EPD_5in83_V2_SendCommand(0x71);
-		DEV_Delay_ms(10);    
-	}
-	while(!DEV_Digital_Read(EPD_BUSY_PIN));   
-	Debug("e-Paper busy release\r\n");
+    Debug("e-Paper busy\r\n");
+    EPD_5in83_V2_SendCommand(0x71);
+    DEV_Delay_ms(10);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
+    Debug("e-Paper busy release\r\n");
 }
 
 /******************************************************************************
@@ -141,18 +139,14 @@ parameter:
 ******************************************************************************/
 void EPD_5in83_V2_Clear(void)
 {
-    UWORD Width, Height, i;
+    UWORD Width, Height;
     Width = (EPD_5in83_V2_WIDTH % 8 == 0)? (EPD_5in83_V2_WIDTH / 8 ): (EPD_5in83_V2_WIDTH / 8 + 1);
     Height = EPD_5in83_V2_HEIGHT;
 
 	EPD_5in83_V2_SendCommand(0x10);
-	for(i=0; i<Width*Height; i++) {
-		EPD_5in83_V2_SendData(0x00);  
-	}
+	DEV_SPI_SendData_Fill(0x00, Width*Height);
 	EPD_5in83_V2_SendCommand(0x13);
-	for(i=0; i<Width*Height; i++) {
-		EPD_5in83_V2_SendData(0x00);  
-	}
+	DEV_SPI_SendData_Fill(0x00, Width*Height);
 	EPD_5in83_V2_TurnOnDisplay();
 }
 
@@ -162,22 +156,14 @@ parameter:
 ******************************************************************************/
 void EPD_5in83_V2_Display(UBYTE *Image)
 {
-    UWORD Width, Height, i, j;
+    UWORD Width, Height;
     Width = (EPD_5in83_V2_WIDTH % 8 == 0)? (EPD_5in83_V2_WIDTH / 8 ): (EPD_5in83_V2_WIDTH / 8 + 1);
     Height = EPD_5in83_V2_HEIGHT;
 
 	EPD_5in83_V2_SendCommand(0x10);
-	for(i=0;i<Height;i++) {
-		for(j=0; j<Width; j++) {
-			EPD_5in83_V2_SendData(0x00);  
-		}
-	}
+	DEV_SPI_SendData_Fill(0x00, Height * Width);
 	EPD_5in83_V2_SendCommand(0x13);
-	for(i=0;i<Height;i++) {
-		for(j=0; j<Width; j++) {
-			EPD_5in83_V2_SendData(~Image[i*Width + j]);  
-		}
-	}
+	DEV_SPI_SendData_nByte_Inverted(Image, Height * Width);
     EPD_5in83_V2_TurnOnDisplay();
 }
 
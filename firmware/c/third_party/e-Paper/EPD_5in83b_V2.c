@@ -78,15 +78,9 @@ parameter:
 void EPD_5IN83B_V2_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-	UBYTE busy;
-	do
-	{
-		EPD_5IN83B_V2_SendCommand(0x71);
-		busy = DEV_Digital_Read(EPD_BUSY_PIN);
-		busy =!(busy & 0x01);
-	}
-	while(busy);   
-	DEV_Delay_ms(200);     
+    EPD_5IN83B_V2_SendCommand(0x71);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(200);
     Debug("e-Paper busy release\r\n");
 }
 
@@ -150,17 +144,10 @@ void EPD_5IN83B_V2_Clear(void)
     UWORD Width, Height;
     Width =(EPD_5IN83B_V2_WIDTH % 8 == 0)?(EPD_5IN83B_V2_WIDTH / 8 ):(EPD_5IN83B_V2_WIDTH / 8 + 1);
     Height = EPD_5IN83B_V2_HEIGHT;
-    UWORD i;
     EPD_5IN83B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_5IN83B_V2_SendData(0xff);
-
-    }
+    DEV_SPI_SendData_Fill(0xff, Width*Height);
     EPD_5IN83B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_5IN83B_V2_SendData(0x00);
-
-    }
+    DEV_SPI_SendData_Fill(0x00, Width*Height);
     EPD_5IN83B_V2_TurnOnDisplay();
 }
 
@@ -175,19 +162,11 @@ void EPD_5IN83B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage)
     Height = EPD_5IN83B_V2_HEIGHT;
 	//send black data
     EPD_5IN83B_V2_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_5IN83B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(blackimage, Height * Width);
 
     //send red data
     EPD_5IN83B_V2_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_5IN83B_V2_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte_Inverted(ryimage, Height * Width);
     EPD_5IN83B_V2_TurnOnDisplay();
 }
 
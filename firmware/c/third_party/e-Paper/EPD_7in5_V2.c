@@ -74,16 +74,18 @@ static void EPD_SendData(UBYTE Data)
 /******************************************************************************
 function :	Wait until the busy_pin goes LOW
 parameter:
+Info:
+	Returns 0 when idle, 1 on BUSY timeout
 ******************************************************************************/
-static void EPD_WaitUntilIdle(void)
+static UBYTE EPD_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-	do{
-		EPD_SendCommand(0x71);
-		DEV_Delay_ms(20);  
-	}while(!(DEV_Digital_Read(EPD_BUSY_PIN)));   
-	DEV_Delay_ms(20);      
+    EPD_SendCommand(0x71);
+    DEV_Delay_ms(20);
+    UBYTE timed_out = DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(20);
     Debug("e-Paper busy release\r\n");
+    return timed_out;
 }
 
 
@@ -91,11 +93,11 @@ static void EPD_WaitUntilIdle(void)
 function :	Turn On Display
 parameter:
 ******************************************************************************/
-static void EPD_7IN5_V2_TurnOnDisplay(void)
+static UBYTE EPD_7IN5_V2_TurnOnDisplay(void)
 {
     EPD_SendCommand(0x12);			//DISPLAY REFRESH
     DEV_Delay_ms(100);	        //!!!The delay here is necessary, 200uS at least!!!
-    EPD_WaitUntilIdle();
+    return EPD_WaitUntilIdle();
 }
 
 /******************************************************************************
@@ -148,22 +150,17 @@ UBYTE EPD_7IN5_V2_Init(void)
 function :	Clear screen
 parameter:
 ******************************************************************************/
-void EPD_7IN5_V2_Clear(void)
+UBYTE EPD_7IN5_V2_Clear(void)
 {
     UWORD Width, Height;
     Width =(EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5_V2_HEIGHT;
 
-    UWORD i;
     EPD_SendCommand(0x10);
-    for(i=0; i<Height*Width; i++) {
-        EPD_SendData(0xFF);
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height*Width);
     EPD_SendCommand(0x13);
-    for(i=0; i<Height*Width; i++)	{
-        EPD_SendData(0x00);
-    }
-    EPD_7IN5_V2_TurnOnDisplay();
+    DEV_SPI_SendData_Fill(0x00, Height*Width);
+    return EPD_7IN5_V2_TurnOnDisplay();
 }
 
 void EPD_7IN5_V2_ClearBlack(void)
@@ -172,41 +169,31 @@ void EPD_7IN5_V2_ClearBlack(void)
     Width =(EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5_V2_HEIGHT;
 
-    UWORD i;
     EPD_SendCommand(0x10);
-    for(i=0; i<Height*Width; i++) {
-        EPD_SendData(0x00);
-    }
+    DEV_SPI_SendData_Fill(0x00, Height*Width);
     EPD_SendCommand(0x13);
-    for(i=0; i<Height*Width; i++) {
-        EPD_SendData(0xFF);
-    }
+    DEV_SPI_SendData_Fill(0xFF, Height*Width);
     EPD_7IN5_V2_TurnOnDisplay();
 }
 
 /******************************************************************************
 function :	Sends the image buffer in RAM to e-Paper and displays
 parameter:
+Info:
+	Returns 0 after the refresh, 1 on BUSY timeout
 ******************************************************************************/
-void EPD_7IN5_V2_Display(const UBYTE *blackimage)
+UBYTE EPD_7IN5_V2_Display(const UBYTE *blackimage)
 {
     UDOUBLE Width, Height;
     Width =(EPD_7IN5_V2_WIDTH % 8 == 0)?(EPD_7IN5_V2_WIDTH / 8 ):(EPD_7IN5_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5_V2_HEIGHT;
-    
-    EPD_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(blackimage[i + j * Width]);
-        }
-    }
-    EPD_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_SendData(~blackimage[i + j * Width]);
-        }
-    }
-    EPD_7IN5_V2_TurnOnDisplay();
+
+    DEV_SPI_Plane planes[2] = {
+        { 0x10, blackimage, Width, Height, Width, false },
+        { 0x13, blackimage, Width, Height, Width, true },
+    };
+    DEV_SPI_Stream(planes, 2); // 0x10 image, 0x13 inverted
+    return EPD_7IN5_V2_TurnOnDisplay();
 }
 
 /******************************************************************************
@@ -41,9 +41,9 @@
 #define EPD_7IN5_V2_HEIGHT      480
 
 UBYTE EPD_7IN5_V2_Init(void);
-void EPD_7IN5_V2_Clear(void);
+UBYTE EPD_7IN5_V2_Clear(void);
 void EPD_7IN5_V2_ClearBlack(void);
-void EPD_7IN5_V2_Display(const UBYTE *blackimage);
+UBYTE EPD_7IN5_V2_Display(const UBYTE *blackimage);
 void EPD_7IN5_V2_Sleep(void);
 
 #endif
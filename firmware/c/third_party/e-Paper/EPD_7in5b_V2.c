@@ -77,11 +77,10 @@ parameter:
 void EPD_7IN5B_V2_WaitUntilIdle(void)
 {
     Debug("e-Paper busy\r\n");
-	do	{
-		DEV_Delay_ms(20);   
-	}while(!(DEV_Digital_Read(EPD_BUSY_PIN)));
-	DEV_Delay_ms(20);      
-	Debug("e-Paper busy release\r\n");
+    DEV_Delay_ms(20);
+    DEV_Wait_Busy(1, DEV_BUSY_TIMEOUT_MS);
+    DEV_Delay_ms(20);
+    Debug("e-Paper busy release\r\n");
 }
 
 
@@ -152,17 +151,10 @@ void EPD_7IN5B_V2_Clear(void)
     Width =(EPD_7IN5B_V2_WIDTH % 8 == 0)?(EPD_7IN5B_V2_WIDTH / 8 ):(EPD_7IN5B_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    DEV_SPI_SendData_Fill(0xff, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    DEV_SPI_SendData_Fill(0x00, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -172,17 +164,10 @@ void EPD_7IN5B_V2_ClearRed(void)
     Width =(EPD_7IN5B_V2_WIDTH % 8 == 0)?(EPD_7IN5B_V2_WIDTH / 8 ):(EPD_7IN5B_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    DEV_SPI_SendData_Fill(0xff, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0xff);
-
-    }
+    DEV_SPI_SendData_Fill(0xff, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -192,17 +177,10 @@ void EPD_7IN5B_V2_ClearBlack(void)
     Width =(EPD_7IN5B_V2_WIDTH % 8 == 0)?(EPD_7IN5B_V2_WIDTH / 8 ):(EPD_7IN5B_V2_WIDTH / 8 + 1);
     Height = EPD_7IN5B_V2_HEIGHT;
 
-    UWORD i;
     EPD_7IN5B_V2_SendCommand(0x10);
-    for(i=0; i<Width*Height; i++) {
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    DEV_SPI_SendData_Fill(0x00, Width*Height);
     EPD_7IN5B_V2_SendCommand(0x13);
-    for(i=0; i<Width*Height; i++)	{
-        EPD_7IN5B_V2_SendData(0x00);
-
-    }
+    DEV_SPI_SendData_Fill(0x00, Width*Height);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
@@ -218,19 +196,11 @@ void EPD_7IN5B_V2_Display(const UBYTE *blackimage, const UBYTE *ryimage)
 
  //send black data
     EPD_7IN5B_V2_SendCommand(0x10);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(blackimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte(blackimage, Height * Width);
 
     //send red data
     EPD_7IN5B_V2_SendCommand(0x13);
-    for (UDOUBLE j = 0; j < Height; j++) {
-        for (UDOUBLE i = 0; i < Width; i++) {
-            EPD_7IN5B_V2_SendData(~ryimage[i + j * Width]);
-        }
-    }
+    DEV_SPI_SendData_nByte_Inverted(ryimage, Height * Width);
     EPD_7IN5B_V2_TurnOnDisplay();
 }
 
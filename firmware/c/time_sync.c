@@ -0,0 +1,332 @@
+/**
+ * @file time_sync.c
+ * @brief SNTP check of the DS3231 and aging-offset calibration.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "pico/rand.h"
+#include "lwip/udp.h"
+#include "lwip/pbuf.h"
+#include "time_sync.h"
+#include "main.h"
+#include "flash.h"
+#include "wake_scheduler.h"
+#include "clock_policy.h"
+#include "debug.h"
+
+#define SNTP_PORT              123
+#define SNTP_MSG_LEN           48
+#define SNTP_MODE_CLIENT       0x23        ///< LI 0, version 4, mode 3
+#define SNTP_MODE_SERVER       4
+#define SNTP_RTC_EPOCH_OFFSET  (3155673600LL - (int64_t)RTC_UTC_OFFSET_MINUTES * 60) ///< NTP seconds at 2000-01-01 00:00 RTC time (config.h time zone)
+#define AGING_PPB_PER_LSB      100         ///< DS3231 aging offset, typical at 25 °C
+
+static struct udp_pcb* sntp_pcb = NULL;
+static uint8_t sntp_nonce[8];              ///< Transmit timestamp of the request, echoed by the server
+static uint64_t sntp_tx_us;
+
+// Set by the receive callback (lwIP context), read on core0 after the radio is off
+static volatile bool reply_received = false;
+static int64_t server_ms_at_rx;            ///< Server time at reply_rx_us, RTC ms since 2000
+static uint64_t reply_rx_us;
+
+static time_sync_t time_sync;
+static int8_t aging_offset;                ///< DS3231 aging register, read by time_sync_init()
+
+static uint64_t read_be64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/**
+ * @brief Converts an NTP timestamp (32.32 fixed point) to RTC ms since 2000.
+ *
+ * Era 0 ends in 2036; smaller values belong to era 1.
+ */
+static int64_t ntp_to_rtc_ms(uint64_t ntp) {
+    uint64_t seconds = ntp >> 32;
+    if (seconds < 0x80000000ULL) {
+        seconds += 0x100000000ULL;
+    }
+    uint64_t ms = ((ntp & 0xFFFFFFFFULL) * 1000) >> 32;
+    return ((int64_t)seconds - SNTP_RTC_EPOCH_OFFSET) * 1000 + (int64_t)ms;
+}
+
+/**
+ * @brief Receives the SNTP reply; the server time at arrival is corrected by half the path delay.
+ */
+static void sntp_recv(void* arg, struct udp_pcb* pcb, struct pbuf* p, const ip_addr_t* addr, u16_t port) {
+    uint64_t rx_us = time_us_64();
+    uint8_t msg[SNTP_MSG_LEN];
+
+    if (!reply_received && p->tot_len >= SNTP_MSG_LEN &&
+        pbuf_copy_partial(p, msg, SNTP_MSG_LEN, 0) == SNTP_MSG_LEN &&
+        (msg[0] & 0x07) == SNTP_MODE_SERVER && (msg[0] >> 6) != 3 &&
+        msg[1] >= 1 && msg[1] <= 15 &&
+        memcmp(&msg[24], sntp_nonce, sizeof(sntp_nonce)) == 0) {
+        int64_t server_rx = ntp_to_rtc_ms(read_be64(&msg[32]));
+        int64_t server_tx = ntp_to_rtc_ms(read_be64(&msg[40]));
+        int64_t delay_ms = (int64_t)(rx_us - sntp_tx_us) / 1000 - (server_tx - server_rx);
+        if (delay_ms < 0) delay_ms = 0;
+
+        server_ms_at_rx = server_tx + delay_ms / 2;
+        reply_rx_us = rx_us;
+        reply_received = true;
+    }
+    pbuf_free(p);
+}
+
+/**
+ * @brief Reads the aging offset programmed in the DS3231; called once at boot.
+ *
+ * The register is the reference for the next adjustment, so a replaced module or
+ * a lost EEPROM record cannot make the calibration start from a wrong value.
+ */
+void time_sync_init(ds3231_t* rtc) {
+    if (ds3231_get_aging_offset(rtc, &aging_offset) != 0) {
+        aging_offset = 0;
+        debug_log_with_color(COLOR_YELLOW, "DS3231 aging offset not readable\n");
+    }
+}
+
+/**
+ * @brief Sends the SNTP request; called as soon as the link is up.
+ */
+void time_sync_start(void) {
+    // 0.0.0.0 (default) disables the check; 255.255.255.255 is erased flash, not a server
+    const uint8_t* server = device_config_flash.data.ntp_server;
+    if ((server[0] | server[1] | server[2] | server[3]) == 0 ||
+        (server[0] & server[1] & server[2] & server[3]) == 0xFF) {
+        return;
+    }
+
+    ip_addr_t ip;
+    IP4_ADDR(&ip, server[0], server[1], server[2], server[3]);
+
+    uint32_t r[2] = {get_rand_32(), get_rand_32()};
+    memcpy(sntp_nonce, r, sizeof(sntp_nonce));
+
+    cyw43_arch_lwip_begin();
+    sntp_pcb = udp_new();
+    struct pbuf* p = (sntp_pcb != NULL) ? pbuf_alloc(PBUF_TRANSPORT, SNTP_MSG_LEN, PBUF_RAM) : NULL;
+    err_t err = ERR_MEM;
+    if (p != NULL) {
+        uint8_t* msg = (uint8_t*)p->payload;
+        memset(msg, 0, SNTP_MSG_LEN);
+        msg[0] = SNTP_MODE_CLIENT;
+        memcpy(&msg[40], sntp_nonce, sizeof(sntp_nonce));
+
+        udp_recv(sntp_pcb, sntp_recv, NULL);
+        sntp_tx_us = time_us_64();
+        err = udp_sendto(sntp_pcb, p, &ip, SNTP_PORT);
+        pbuf_free(p);
+    }
+    cyw43_arch_lwip_end();
+
+    if (err != ERR_OK) {
+        debug_log_with_color(COLOR_YELLOW, "SNTP request not sent: %d\n", err);
+    }
+}
+
+/**
+ * @brief Stops listening for the reply; must be called before cyw43_arch_deinit().
+ */
+void time_sync_stop(void) {
+    if (sntp_pcb == NULL) {
+        return;
+    }
+
+    cyw43_arch_lwip_begin();
+    udp_remove(sntp_pcb);
+    sntp_pcb = NULL;
+    cyw43_arch_lwip_end();
+
+    if (!reply_received) {
+        debug_log("SNTP: no reply within the server exchange\n");
+    }
+}
+
+static void load_time_sync(ds3231_t* rtc) {
+    if (at24c32_read(rtc, EEPROM_TIME_SYNC_ADDR, (uint8_t*)&time_sync, sizeof(time_sync)) == 0 &&
+        time_sync.data.magic == TIME_SYNC_MAGIC &&
+        time_sync.data.size == sizeof(time_sync_data_t) &&
+        calc_crc32(&time_sync.data, sizeof(time_sync_data_t)) == time_sync.crc32) {
+        return;
+    }
+
+    memset(&time_sync, 0, sizeof(time_sync));
+    time_sync.data.magic = TIME_SYNC_MAGIC;
+    time_sync.data.size = sizeof(time_sync_data_t);
+}
+
+static bool save_time_sync(ds3231_t* rtc) {
+    time_sync.crc32 = calc_crc32(&time_sync.data, sizeof(time_sync_data_t));
+    if (at24c32_write(rtc, EEPROM_TIME_SYNC_ADDR, (const uint8_t*)&time_sync, sizeof(time_sync)) != 0) {
+        debug_log_with_color(COLOR_RED, "EEPROM write of time sync record failed\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Sets the RTC to the server time at the next full second.
+ *
+ * Writing the seconds register restarts the DS3231 countdown chain, so the
+ * new second starts with the write.
+ *
+ * @return RTC seconds since 2000 that were written, 0 on error.
+ */
+static uint32_t set_rtc_to_server_time(ds3231_t* rtc) {
+    int64_t now_ms = server_ms_at_rx + (int64_t)(time_us_64() - reply_rx_us) / 1000;
+    int64_t target_ms = ((now_ms + 10) / 1000 + 1) * 1000; // Leave time for the I2C write
+    uint32_t target_s = (uint32_t)(target_ms / 1000);
+
+    ds3231_data_t t;
+    rtc_minutes_to_time(target_s / 60, &t);
+    t.seconds = target_s % 60;
+    t.century = 1;
+    t.am_pm = false;
+
+    clock_policy_wait();
+    sleep_until(from_us_since_boot(reply_rx_us + (uint64_t)(target_ms - server_ms_at_rx) * 1000));
+    clock_policy_run();
+
+    if (ds3231_configure_time(rtc, &t) != 0) {
+        debug_log_with_color(COLOR_RED, "SNTP: setting the RTC failed\n");
+        return 0;
+    }
+    return target_s;
+}
+
+/**
+ * @brief Compares the RTC with the SNTP reply, corrects it and adjusts the aging offset.
+ *
+ * Runs on core0 while core1 pushes the frame (core1 does not use the I2C bus)
+ * and before the alarm is set. Does nothing if no reply arrived in this wake.
+ *
+ * @param rtc DS3231 instance.
+ * @return true if the RTC was set.
+ */
+bool time_sync_apply(ds3231_t* rtc) {
+    if (!reply_received) {
+        return false;
+    }
+    reply_received = false;
+
+    ds3231_data_t now;
+    if (ds3231_read_current_time(rtc, &now) != 0) {
+        return false;
+    }
+    uint64_t read_us = time_us_64();
+    load_time_sync(rtc);
+
+    const device_config_data_t* cfg = &device_config_flash.data;
+    time_sync_data_t* d = &time_sync.data;
+    uint32_t rtc_s = rtc_minutes_since_2000(&now) * 60 + now.seconds;
+    int64_t server_ms = server_ms_at_rx + (int64_t)(read_us - reply_rx_us) / 1000;
+    int64_t error_ms = (int64_t)rtc_s * 1000 + 500 - server_ms; // RTC second count, mid-second on average
+
+    time_sync_entry_t entry = {
+        .rtc_minutes = rtc_s / 60,
+        .error_ms = (int32_t)MAX(MIN(error_ms, INT32_MAX), INT32_MIN),
+        .aging_offset = aging_offset
+    };
+
+    // Drift since the baseline, only over a long enough interval
+    int64_t drift_ppb = 0;
+    if (d->reference_s != 0 && rtc_s > d->reference_s + TIME_SYNC_MIN_BASELINE_HOURS * 3600) {
+        drift_ppb = (error_ms - d->reference_error_ms) * 1000000 / (int64_t)(rtc_s - d->reference_s);
+        if (llabs(drift_ppb) > TIME_SYNC_MAX_DRIFT_PPM * 1000) {
+            drift_ppb = 0;
+        }
+    }
+    entry.drift_ppm10 = (int16_t)(drift_ppb / 100);
+
+    bool corrected = false;
+    if (cfg->ntp_threshold_seconds > 0 && llabs(error_ms) >= (int64_t)cfg->ntp_threshold_seconds * 1000) {
+        uint32_t set_s = set_rtc_to_server_time(rtc);
+        if (set_s != 0) {
+            corrected = true;
+            entry.corrected = 1;
+
+            // A fast RTC (positive drift) is slowed down by a larger aging offset; half a step damps the noise
+            if (drift_ppb != 0) {
+                int aging = aging_offset + (int)(drift_ppb / AGING_PPB_PER_LSB / 2);
+                aging = MAX(MIN(aging, 127), -127);
+                if (aging != aging_offset && ds3231_set_aging_offset(rtc, (int8_t)aging) == 0) {
+                    ds3231_force_convert_temperature(rtc); // The offset takes effect with the next conversion
+                    aging_offset = (int8_t)aging;
+                    entry.aging_offset = (int8_t)aging;
+                }
+            }
+            // Without a drift estimate (first sync, implausible jump) the baseline starts over
+            d->reference_s = set_s;
+            d->reference_error_ms = 0;
+        }
+    } else if (d->reference_s == 0) {
+        // Within the threshold: good enough as baseline, the remaining error is subtracted later
+        d->reference_s = rtc_s;
+        d->reference_error_ms = entry.error_ms;
+    }
+
+    debug_log_with_color(corrected ? COLOR_YELLOW : COLOR_GREEN,
+                         "SNTP: RTC %+ld ms, drift %+.1f ppm, aging offset %d%s\n",
+                         (long)entry.error_ms, entry.drift_ppm10 / 10.0f,
+                         entry.aging_offset, corrected ? ", RTC set" : "");
+
+    d->history[d->head] = entry;
+    d->head = (d->head + 1) % TIME_SYNC_HISTORY;
+    save_time_sync(rtc);
+    return corrected;
+}
+
+/**
+ * @brief The clock was set by hand (/clock): the next drift estimate must not use the old baseline.
+ */
+void time_sync_clock_set_manually(ds3231_t* rtc) {
+    load_time_sync(rtc);
+    time_sync.data.reference_s = 0;
+    time_sync.data.reference_error_ms = 0;
+    save_time_sync(rtc);
+}
+
+/**
+ * @brief Formats the aging offset and the comparison log (newest first) as HTML for the clock page.
+ *
+ * @return Length of the text in `buffer`.
+ */
+size_t time_sync_format_history(ds3231_t* rtc, char* buffer, size_t buffer_size) {
+    load_time_sync(rtc);
+    const time_sync_data_t* d = &time_sync.data;
+
+    size_t len = snprintf(buffer, buffer_size,
+                          "<div class='section'>Aging offset: <span class='value'>%d</span></div>"
+                          "<table style='margin:auto'><tr><th>RTC</th><th>Error</th><th>Drift</th><th>Aging</th><th></th></tr>",
+                          aging_offset);
+
+    for (int i = 1; i <= TIME_SYNC_HISTORY && len < buffer_size; i++) {
+        const time_sync_entry_t* e = &d->history[(d->head + TIME_SYNC_HISTORY - i) % TIME_SYNC_HISTORY];
+        if (e->rtc_minutes == 0) {
+            break;
+        }
+
+        ds3231_data_t t;
+        rtc_minutes_to_time(e->rtc_minutes, &t);
+        len += snprintf(buffer + len, buffer_size - len,
+                        "<tr><td>%02d.%02d.%04d %02d:%02d</td><td>%+ld ms</td><td>%+.1f ppm</td><td>%d</td><td>%s</td></tr>",
+                        t.date, t.month, 2000 + t.year, t.hours, t.minutes,
+                        (long)e->error_ms, e->drift_ppm10 / 10.0f,
+                        e->aging_offset, e->corrected ? "set" : "");
+    }
+    if (len < buffer_size) {
+        len += snprintf(buffer + len, buffer_size - len, "</table>");
+    }
+    return MIN(len, buffer_size - 1);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file time_sync.h
+ * @brief SNTP check of the DS3231 and aging-offset calibration.
+ *
+ * While the radio is up for the server request anyway, a single SNTP packet
+ * is sent to `ntp_server`. If the reply arrives before the HTTP response is
+ * complete, the RTC is compared against it while core1 pushes the frame (only
+ * core0 uses the I2C bus); no extra radio-on time is spent waiting for it.
+ *
+ * - An error of at least `ntp_threshold_seconds` sets the RTC, aligned to the
+ *   next full second.
+ * - The error accumulated since the baseline (the previous correction, or the
+ *   first comparison within the threshold) gives the drift of the oscillator;
+ *   half of it is compensated with the DS3231 aging offset (about 0.1 ppm per
+ *   LSB), so corrections become rarer over time. The offset is read from the
+ *   DS3231 at boot, the EEPROM only logs it.
+ * - Every comparison is logged in a ring in the EEPROM, shown on the clock
+ *   page of the setup mode.
+ *
+ * The RTC has a resolution of one second, so a single comparison is only
+ * accurate to +/-0.5 s; the drift is estimated over at least
+ * TIME_SYNC_MIN_BASELINE_HOURS.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ds3231.h"
+
+#define EEPROM_TIME_SYNC_ADDR       0x140
+#define EEPROM_TIME_SYNC_SIZE       0x100
+#define TIME_SYNC_MAGIC             0x534E5450  // "SNTP"
+#define TIME_SYNC_HISTORY           16          ///< Logged comparisons
+#define TIME_SYNC_MIN_BASELINE_HOURS 72         ///< Shortest interval for a drift estimate
+#define TIME_SYNC_MAX_DRIFT_PPM     100         ///< Larger "drift" is a manual change or a dead coin cell
+
+/**
+ * @brief One comparison of the RTC against the time server.
+ */
+typedef struct {
+    uint32_t rtc_minutes;      ///< RTC time of the comparison (before a correction)
+    int32_t  error_ms;         ///< RTC minus server time
+    int16_t  drift_ppm10;      ///< Drift since the last correction in 0.1 ppm, positive = fast (0 = no estimate)
+    int8_t   aging_offset;     ///< Aging offset programmed after this comparison
+    uint8_t  corrected;        ///< 1 if the RTC was set
+} time_sync_entry_t;
+
+typedef struct {
+    uint32_t magic;            ///< TIME_SYNC_MAGIC
+    uint16_t size;             ///< sizeof(time_sync_data_t)
+    uint8_t  head;             ///< Next slot in `history`
+    uint8_t  reserved;
+    uint32_t reference_s;      ///< RTC seconds since 2000 of the drift baseline (0 = none)
+    int32_t  reference_error_ms; ///< RTC error at the baseline (0 after a correction)
+    time_sync_entry_t history[TIME_SYNC_HISTORY];
+} time_sync_data_t;
+
+typedef struct {
+    time_sync_data_t data;
+    uint32_t crc32;
+} time_sync_t;
+
+_Static_assert(sizeof(time_sync_t) <= EEPROM_TIME_SYNC_SIZE, "time_sync_t exceeds its EEPROM region");
+
+void time_sync_init(ds3231_t* rtc);
+void time_sync_start(void);
+void time_sync_stop(void);
+bool time_sync_apply(ds3231_t* rtc);
+void time_sync_clock_set_manually(ds3231_t* rtc);
+size_t time_sync_format_history(ds3231_t* rtc, char* buffer, size_t buffer_size);
@@ -0,0 +1,93 @@
+/**
+ * @file wake_context.c
+ * @brief Sensor snapshot taken once at boot and handed to all renderers.
+ */
+
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "wake_context.h"
+#include "main.h"
+#include "debug.h"
+
+static absolute_time_t divider_settled;
+
+/**
+ * @brief Mean of WAKE_CONTEXT_ADC_SAMPLES conversions of an ADC GPIO (26-29), scaled to volts.
+ *
+ * The conversions run free-running into the ADC FIFO and are moved by a DMA
+ * channel, the CPU only waits for the transfer.
+ */
+float wake_context_adc_read(unsigned int gpio, float conversion_factor) {
+    static bool adc_ready = false;
+    uint16_t samples[WAKE_CONTEXT_ADC_DISCARD + WAKE_CONTEXT_ADC_SAMPLES];
+
+    if (!adc_ready) {
+        adc_init();
+        adc_ready = true;
+    }
+    adc_gpio_init(gpio);
+    adc_select_input(gpio - 26);
+    adc_fifo_setup(true, true, 1, false, false); // FIFO with DREQ, no error bit, 12-bit samples
+    adc_set_clkdiv(0);                           // Back-to-back conversions, 500 kS/s
+    adc_fifo_drain();
+
+    int chan = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+    channel_config_set_read_increment(&cfg, false);
+    channel_config_set_write_increment(&cfg, true);
+    channel_config_set_dreq(&cfg, DREQ_ADC);
+    dma_channel_configure(chan, &cfg, samples, &adc_hw->fifo, count_of(samples), true);
+
+    adc_run(true);
+    dma_channel_wait_for_finish_blocking(chan);
+    adc_run(false);
+    adc_fifo_drain();
+    dma_channel_unclaim(chan);
+
+    uint32_t sum = 0;
+    for (int i = WAKE_CONTEXT_ADC_DISCARD; i < (int)count_of(samples); i++) {
+        sum += samples[i];
+    }
+    return (float)sum / WAKE_CONTEXT_ADC_SAMPLES * conversion_factor;
+}
+
+/**
+ * @brief Switches the coin-cell divider on and measures the battery while it settles.
+ */
+void wake_context_begin(wake_context_t* ctx, float conversion_factor) {
+    memset(ctx, 0, sizeof(*ctx));
+
+    gpio_init(WAKE_CONTEXT_DIVIDER_GPIO);
+    gpio_set_dir(WAKE_CONTEXT_DIVIDER_GPIO, GPIO_OUT);
+    gpio_put(WAKE_CONTEXT_DIVIDER_GPIO, 1);
+    divider_settled = make_timeout_time_us(WAKE_CONTEXT_SETTLE_US);
+
+    ctx->battery_voltage = wake_context_adc_read(WAKE_CONTEXT_BATTERY_GPIO, conversion_factor);
+}
+
+/**
+ * @brief Reads time and temperature from the DS3231 (I2C must be initialized).
+ */
+void wake_context_read_rtc(wake_context_t* ctx, ds3231_t* rtc) {
+    ctx->time_valid = (ds3231_read_current_time(rtc, &ctx->time) == 0);
+    ctx->rtc_minutes = rtc_minutes_since_2000(&ctx->time);
+    if (ds3231_read_temperature(rtc, &ctx->temperature) != 0) {
+        ctx->temperature = 0.0f;
+    }
+}
+
+/**
+ * @brief Measures the coin cell and switches its divider off again.
+ */
+void wake_context_finish(wake_context_t* ctx, float conversion_factor) {
+    sleep_until(divider_settled); // Usually already passed during the RTC init
+    ctx->coin_cell_voltage = wake_context_adc_read(WAKE_CONTEXT_COIN_CELL_GPIO, conversion_factor);
+    gpio_put(WAKE_CONTEXT_DIVIDER_GPIO, 0);
+
+    debug_log("Wake context: Vcc %.3f V, Vbat %.3f V, %.2f °C, RTC %02d:%02d:%02d\n",
+              ctx->battery_voltage, ctx->coin_cell_voltage, ctx->temperature,
+              ctx->time.hours, ctx->time.minutes, ctx->time.seconds);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file wake_context.h
+ * @brief Sensor snapshot taken once at boot and handed to all renderers.
+ *
+ * The acquisition is split in two so the settling time of the coin-cell
+ * divider overlaps with the I2C work of the RTC init:
+ *
+ * 1. wake_context_begin(): switches the divider on, samples the battery.
+ * 2. wake_context_read_rtc(): time and temperature of the DS3231.
+ * 3. wake_context_finish(): samples the coin cell once the divider has
+ *    settled and switches it off again.
+ *
+ * Each ADC value is the mean of WAKE_CONTEXT_ADC_SAMPLES conversions moved
+ * from the ADC FIFO by DMA at the full 500 kS/s (about 130 µs per input).
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include "ds3231.h"
+
+#define WAKE_CONTEXT_ADC_SAMPLES    64   ///< Averaged conversions per input
+#define WAKE_CONTEXT_ADC_DISCARD    2    ///< Conversions dropped after switching the input
+#define WAKE_CONTEXT_SETTLE_US      5000 ///< Coin-cell divider settling time
+#define WAKE_CONTEXT_BATTERY_GPIO   26   ///< ADC0, battery divider
+#define WAKE_CONTEXT_COIN_CELL_GPIO 27   ///< ADC1, coin-cell divider
+#define WAKE_CONTEXT_DIVIDER_GPIO   14   ///< MOSFET of the coin-cell divider
+
+typedef struct {
+    ds3231_data_t time;        ///< RTC time at boot (standard time)
+    uint32_t rtc_minutes;      ///< `time` as RTC minutes since 2000
+    bool time_valid;           ///< RTC could be read
+    float temperature;         ///< DS3231 temperature in °C (0.25 °C steps)
+    float battery_voltage;     ///< Vcc of the battery pack
+    float coin_cell_voltage;   ///< Backup cell of the DS3231
+} wake_context_t;
+
+void wake_context_begin(wake_context_t* ctx, float conversion_factor);
+void wake_context_read_rtc(wake_context_t* ctx, ds3231_t* rtc);
+void wake_context_finish(wake_context_t* ctx, float conversion_factor);
+
+float wake_context_adc_read(unsigned int gpio, float conversion_factor);
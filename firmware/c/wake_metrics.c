@@ -0,0 +1,168 @@
+/**
+ * @file wake_metrics.c
+ * @brief Per-wake phase timing, kept in a ring of records in the AT24C32 EEPROM.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "wake_metrics.h"
+#include "eeprom.h"
+#include "flash.h"
+#include "debug.h"
+
+static uint64_t phase_start_us[WAKE_PHASE_COUNT];
+static uint32_t phase_duration_ms[WAKE_PHASE_COUNT];
+static int refresh_mode = -1;   // epaper_refresh_mode_t of this wake, -1 = no refresh
+
+// Records not reported to the server yet, read before core1 starts (shared I2C bus)
+static wake_record_t pending[WAKE_LOG_UPLOAD_MAX];
+static int pending_count = 0;
+
+static const char* const phase_names[WAKE_PHASE_COUNT] = {
+    "hold_power", "adc", "rtc_init", "wifi_init", "wifi_associate", "http",
+    "epaper_init", "render", "display", "power_down", "total"
+};
+
+/**
+ * @brief Returns the metric label of a phase.
+ */
+const char* wake_metrics_phase_name(wake_phase_t phase) {
+    return (phase < WAKE_PHASE_COUNT) ? phase_names[phase] : "unknown";
+}
+
+/**
+ * @brief Marks the start of a phase.
+ */
+void wake_metrics_begin(wake_phase_t phase) {
+    phase_start_us[phase] = time_us_64();
+}
+
+/**
+ * @brief Marks the end of a phase. Repeated begin/end pairs accumulate.
+ */
+void wake_metrics_end(wake_phase_t phase) {
+    phase_duration_ms[phase] += (uint32_t)((time_us_64() - phase_start_us[phase]) / 1000);
+}
+
+/**
+ * @brief Records the waveform of this wake's panel refresh (epaper_refresh_mode_t).
+ */
+void wake_metrics_set_refresh(int mode) {
+    refresh_mode = mode;
+}
+
+static uint16_t slot_address(uint16_t seq) {
+    return EEPROM_WAKE_LOG_ADDR + (seq % WAKE_LOG_RECORDS) * sizeof(wake_record_t);
+}
+
+static uint8_t record_crc8(const wake_record_t* r) {
+    return (uint8_t)calc_crc32(r, offsetof(wake_record_t, crc8));
+}
+
+/**
+ * @brief Writes the record of this wake to the EEPROM ring.
+ *
+ * The sequence number is kept in the wake state and persisted with save_wake_state().
+ *
+ * @return true on success.
+ */
+bool wake_metrics_write(ds3231_t* rtc, uint32_t rtc_minutes, float battery_voltage, int pushbutton, int wifi_result) {
+    wake_record_t r;
+    memset(&r, 0, sizeof(r));
+
+    uint16_t seq = wake_state.data.metrics_seq + 1;
+    if (seq == 0) seq = 1;
+
+    phase_duration_ms[WAKE_PHASE_TOTAL] = (uint32_t)(time_us_64() / 1000);
+
+    r.seq = seq;
+    r.rtc_minutes = rtc_minutes;
+    for (int i = 0; i < WAKE_PHASE_COUNT; i++) {
+        r.phase_ms[i] = (uint16_t)MIN(phase_duration_ms[i], UINT16_MAX);
+    }
+    r.battery_mv = (uint16_t)(battery_voltage * 1000.0f);
+    r.flags = WAKE_FLAGS(pushbutton, wifi_result, refresh_mode < 0 ? 0 : refresh_mode, refresh_mode >= 0);
+    r.crc8 = record_crc8(&r);
+
+    if (at24c32_write(rtc, slot_address(seq), (const uint8_t*)&r, sizeof(r)) != 0) {
+        debug_log_with_color(COLOR_RED, "EEPROM write of wake record failed\n");
+        return false;
+    }
+    wake_state.data.metrics_seq = seq;
+
+    debug_log("Wake record #%u: total %u ms\n", seq, r.phase_ms[WAKE_PHASE_TOTAL]);
+    return true;
+}
+
+/**
+ * @brief Reads the record with the given sequence number from the ring.
+ *
+ * @return true if the slot holds a valid record with this sequence number.
+ */
+bool wake_metrics_read(ds3231_t* rtc, uint16_t seq, wake_record_t* out) {
+    if (seq == 0 || at24c32_read(rtc, slot_address(seq), (uint8_t*)out, sizeof(*out)) != 0) {
+        return false;
+    }
+    return out->seq == seq && out->crc8 == record_crc8(out);
+}
+
+/**
+ * @brief Reads the records not yet reported to the server (at most WAKE_LOG_UPLOAD_MAX, newest first).
+ */
+void wake_metrics_load_pending(ds3231_t* rtc) {
+    uint16_t seq = wake_state.data.metrics_seq;
+    pending_count = 0;
+
+    while (pending_count < WAKE_LOG_UPLOAD_MAX && seq != 0 && seq != wake_state.data.metrics_uploaded_seq) {
+        if (!wake_metrics_read(rtc, seq, &pending[pending_count])) {
+            break;
+        }
+        pending_count++;
+        seq--;
+    }
+}
+
+/**
+ * @brief Formats the pending records as HTTP header line for the next server request.
+ *
+ * Format: "X-Inki-Wake: seq,rtc_minutes,battery_mv,flags,phase_ms...;..." (newest first).
+ *
+ * @return Length of the header line, 0 if nothing is pending.
+ */
+size_t wake_metrics_format_upload(char* buffer, size_t buffer_size) {
+    size_t len = 0;
+    buffer[0] = '\0';
+
+    if (pending_count == 0) {
+        return 0;
+    }
+
+    len += snprintf(buffer + len, buffer_size - len, "X-Inki-Wake: ");
+    for (int i = 0; i < pending_count && len < buffer_size; i++) {
+        const wake_record_t* r = &pending[i];
+        len += snprintf(buffer + len, buffer_size - len, "%s%u,%lu,%u,%u",
+                        i ? ";" : "", r->seq, (unsigned long)r->rtc_minutes, r->battery_mv, r->flags);
+        for (int p = 0; p < WAKE_PHASE_COUNT && len < buffer_size; p++) {
+            len += snprintf(buffer + len, buffer_size - len, ",%u", r->phase_ms[p]);
+        }
+    }
+    if (len < buffer_size) {
+        len += snprintf(buffer + len, buffer_size - len, "\r\n");
+    }
+    if (len >= buffer_size) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    return len;
+}
+
+/**
+ * @brief Marks the pending records as reported after a successful server exchange.
+ */
+void wake_metrics_upload_done(void) {
+    if (pending_count > 0) {
+        wake_state.data.metrics_uploaded_seq = pending[0].seq;
+        pending_count = 0;
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file wake_metrics.h
+ * @brief Per-wake phase timing, kept in a ring of records in the AT24C32 EEPROM.
+ *
+ * Every wake measures the duration of its phases with time_us_64() and stores
+ * one 32-byte record (one EEPROM page) in a ring. The setup webserver shows
+ * the ring as table (/wake_log) and as Prometheus text (/metrics); records that
+ * have not been reported yet are sent along with the next server request
+ * (X-Inki-Wake header).
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ds3231.h"
+
+#define EEPROM_WAKE_LOG_ADDR        0x400
+#define WAKE_LOG_RECORDS            64                   ///< Ring size (64 x 32 B = 2 KB)
+#define WAKE_LOG_UPLOAD_MAX         4                    ///< Records per server request
+
+/**
+ * @brief Measured phases of a wake cycle. Phases on core0 and core1 overlap.
+ */
+typedef enum {
+    WAKE_PHASE_HOLD_POWER = 0, ///< Boot until the power gate is held
+    WAKE_PHASE_ADC,            ///< Battery voltage measurement
+    WAKE_PHASE_RTC_INIT,       ///< DS3231 init, EEPROM state
+    WAKE_PHASE_WIFI_INIT,      ///< cyw43 init and start of the association
+    WAKE_PHASE_WIFI_ASSOCIATE, ///< Association and IP address
+    WAKE_PHASE_HTTP,           ///< Server request until the response is complete
+    WAKE_PHASE_EPAPER_INIT,    ///< Framebuffer allocation, panel reset/init
+    WAKE_PHASE_RENDER,         ///< Page rendering (core1)
+    WAKE_PHASE_DISPLAY,        ///< Frame push, refresh incl. BUSY, panel sleep (core1)
+    WAKE_PHASE_POWER_DOWN,     ///< Base frame store after core1 has finished
+    WAKE_PHASE_TOTAL,          ///< Boot until the record is written
+    WAKE_PHASE_COUNT
+} wake_phase_t;
+
+/**
+ * @brief One wake cycle as stored in the EEPROM ring.
+ */
+typedef struct __attribute__((packed)) {
+    uint16_t seq;                         ///< Running number (never 0 for a used slot)
+    uint32_t rtc_minutes;                 ///< Wake time, RTC minutes since 2000
+    uint16_t phase_ms[WAKE_PHASE_COUNT];  ///< Phase durations in ms
+    uint16_t battery_mv;                  ///< Battery voltage at wake
+    uint8_t  flags;                       ///< Page (bits 0-2), WifiResult (3-4), refresh mode (5-6), refreshed (7)
+    uint8_t  crc8;                        ///< Low byte of the CRC32 of the preceding bytes
+} wake_record_t;
+
+_Static_assert(sizeof(wake_record_t) == 32, "wake_record_t must fill one EEPROM page");
+
+#define WAKE_FLAGS(page, wifi, mode, refreshed) \
+    (uint8_t)(((page) & 0x07) | (((wifi) & 0x03) << 3) | (((mode) & 0x03) << 5) | ((refreshed) ? 0x80 : 0))
+
+void wake_metrics_begin(wake_phase_t phase);
+void wake_metrics_end(wake_phase_t phase);
+void wake_metrics_set_refresh(int mode);
+bool wake_metrics_write(ds3231_t* rtc, uint32_t rtc_minutes, float battery_voltage, int pushbutton, int wifi_result);
+
+bool wake_metrics_read(ds3231_t* rtc, uint16_t seq, wake_record_t* out);
+void wake_metrics_load_pending(ds3231_t* rtc);
+size_t wake_metrics_format_upload(char* buffer, size_t buffer_size);
+void wake_metrics_upload_done(void);
+
+const char* wake_metrics_phase_name(wake_phase_t phase);
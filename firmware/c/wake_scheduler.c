@@ -0,0 +1,341 @@
+/**
+ * @file wake_scheduler.c
+ * @brief Booking-aware computation of the next RTC wake-up.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wake_scheduler.h"
+#include "main.h"
+#include "flash.h"
+#include "eeprom.h"
+#include "power_governor.h"
+#include "schedule.h"
+#include "debug.h"
+#include "pico/unique_id.h"
+
+booking_schedule_t booking_schedule;
+
+static bool retry_pending = false; // This wake ended with a Wi-Fi or server error
+
+/**
+ * @brief Parses an ISO 8601 timestamp ("2025-08-03T09:00:00+02:00", "...Z") into RTC minutes.
+ *
+ * The timestamp is converted to UTC using its offset and then to the
+ * standard time the RTC runs on.
+ *
+ * @return true on success.
+ */
+static bool parse_iso8601(const char* s, uint32_t* rtc_minutes) {
+    int year, month, date, hour, minute;
+    int consumed = 0;
+
+    if (sscanf(s, "%4d-%2d-%2dT%2d:%2d%n", &year, &month, &date, &hour, &minute, &consumed) != 5 ||
+        year < 2000 || year > 2099 || month < 1 || month > 12) {
+        return false;
+    }
+
+    // Skip seconds and fractions, then read the UTC offset
+    const char* p = s + consumed;
+    while (*p == ':' || *p == '.' || (*p >= '0' && *p <= '9')) p++;
+
+    int offset = 0;
+    if (*p == '+' || *p == '-') {
+        int off_h = 0, off_m = 0;
+        sscanf(p + 1, "%2d:%2d", &off_h, &off_m);
+        offset = off_h * 60 + off_m;
+        if (*p == '-') offset = -offset;
+    }
+
+    ds3231_data_t t = {
+        .minutes = (uint8_t)minute,
+        .hours = (uint8_t)hour,
+        .date = (uint8_t)date,
+        .month = (uint8_t)month,
+        .year = (uint8_t)(year - 2000)
+    };
+    *rtc_minutes = rtc_minutes_since_2000(&t) - offset + RTC_UTC_OFFSET_MINUTES;
+    return true;
+}
+
+/**
+ * @brief Returns the position after the bracket that closes the object/array opened
+ *        just before `p` (nested blocks and strings skipped), or NULL if the text ends first.
+ */
+static const char* json_block_end(const char* p) {
+    int depth = 1;
+    bool in_string = false;
+    for (; *p; p++) {
+        if (in_string) {
+            if (*p == '\\' && p[1]) p++;
+            else if (*p == '"') in_string = false;
+        } else if (*p == '"') {
+            in_string = true;
+        } else if (*p == '[' || *p == '{') {
+            depth++;
+        } else if ((*p == ']' || *p == '}') && --depth == 0) {
+            return p + 1;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Finds `key` within [from, to), NULL if it is not there.
+ */
+static const char* json_find_key(const char* from, const char* to, const char* key) {
+    const char* k = strstr(from, key);
+    return (k != NULL && k < to) ? k : NULL;
+}
+
+/**
+ * @brief Extracts the bookings ("enter"/"leave" of each object in the "bookings" array) from the server response.
+ *
+ * @param json Server response (header and body).
+ * @param out  Parsed bookings; `valid` is set if a "bookings" array was found.
+ */
+void wake_scheduler_parse_bookings(const char* json, booking_schedule_t* out) {
+    memset(out, 0, sizeof(*out));
+
+    const char* p = strstr(json, "\"bookings\":[");
+    if (p == NULL) {
+        return;
+    }
+    p += strlen("\"bookings\":[");
+
+    const char* end = json_block_end(p);
+    if (end == NULL) {
+        return; // Truncated response
+    }
+    out->valid = true;
+
+    // One booking per object of the array, independent of the order of its fields
+    while (out->count < WAKE_SCHEDULER_MAX_BOOKINGS) {
+        const char* object = strchr(p, '{');
+        if (object == NULL || object >= end) {
+            break;
+        }
+        const char* object_end = json_block_end(object + 1);
+        if (object_end == NULL || object_end > end) {
+            break;
+        }
+
+        const char* enter = json_find_key(object, object_end, "\"enter\":\"");
+        const char* leave = json_find_key(object, object_end, "\"leave\":\"");
+        uint32_t enter_min, leave_min;
+        if (enter != NULL && leave != NULL &&
+            parse_iso8601(enter + strlen("\"enter\":\""), &enter_min) &&
+            parse_iso8601(leave + strlen("\"leave\":\""), &leave_min) && leave_min > enter_min) {
+            out->enter[out->count] = enter_min;
+            out->leave[out->count] = leave_min;
+            out->count++;
+        }
+        p = object_end;
+    }
+
+    debug_log("Bookings in response: %d\n", out->count);
+}
+
+/**
+ * @brief Formats RTC minutes as ISO 8601 with the RTC offset, URL-encoded for a query string
+ *        (e.g. "2025-08-03T13:27:00%2B01:00").
+ */
+void wake_scheduler_format_time(uint32_t rtc_minutes, char* buffer, size_t buffer_size) {
+    ds3231_data_t t;
+    rtc_minutes_to_time(rtc_minutes, &t);
+
+    const int offset = RTC_UTC_OFFSET_MINUTES;
+    const int offset_abs = (offset < 0) ? -offset : offset;
+    snprintf(buffer, buffer_size, "%04d-%02d-%02dT%02d:%02d:00%s%02d:%02d",
+             2000 + t.year, t.month, t.date, t.hours, t.minutes,
+             (offset < 0) ? "-" : "%2B", offset_abs / 60, offset_abs % 60);
+}
+
+/**
+ * @brief Minutes until the displayed booking state changes, bounded by the ceilings.
+ *
+ * While a booking is active the ceiling is `wake_ceiling_minutes` (e.g. a desk booked
+ * all day wakes once at the end of the booking); while the seat is free, the page 0
+ * refresh interval is the ceiling so that new bookings still appear.
+ */
+static int minutes_until_booking_change(uint32_t now, bool* at_change) {
+    const device_config_data_t* cfg = &device_config_flash.data;
+    bool occupied = false;
+    uint32_t next_change = UINT32_MAX;
+
+    for (int i = 0; i < booking_schedule.count; i++) {
+        uint32_t enter = booking_schedule.enter[i];
+        uint32_t leave = booking_schedule.leave[i];
+
+        if (enter <= now && now < leave) {
+            occupied = true;
+        }
+        if (enter > now && enter < next_change) next_change = enter;
+        if (leave > now && leave < next_change) next_change = leave;
+    }
+
+    int ceiling = power_governor_refresh_minutes(occupied ? cfg->wake_ceiling_minutes : cfg->refresh_minutes_by_pushbutton[0]);
+    int delay = ceiling;
+    *at_change = false;
+    if (next_change != UINT32_MAX && next_change - now < (uint32_t)ceiling) {
+        delay = (int)(next_change - now);
+        *at_change = true;
+    }
+
+    debug_log("Wake scheduler: %s, next booking change in %ld min, sleeping %d min\n",
+              occupied ? "booked" : "free",
+              (next_change == UINT32_MAX) ? -1L : (long)(next_change - now), delay);
+    return delay;
+}
+
+/**
+ * @brief Updates the failure streak with the result of this wake's server update.
+ *
+ * Errors extend the streak and make the next wake a retry, a success resets it;
+ * wakes without Wi-Fi leave it unchanged. Persisted with save_wake_state().
+ */
+void wake_scheduler_record_result(WifiResult result) {
+    if (result == WIFI_SUCCESS) {
+        wake_state.data.failure_streak = 0;
+    } else if (result == WIFI_ERROR_CONNECTION || result == WIFI_ERROR_SERVER) {
+        if (wake_state.data.failure_streak < UINT8_MAX) {
+            wake_state.data.failure_streak++;
+        }
+        retry_pending = true;
+    }
+}
+
+/**
+ * @brief Retry delay for the current failure streak (1 failure = `wifi_reconnect_minutes`).
+ */
+static int retry_delay_minutes(void) {
+    int delay = device_config_flash.data.wifi_reconnect_minutes;
+    int doublings = wake_state.data.failure_streak - 1;
+
+    if (delay < 1) delay = 1;
+    while (doublings-- > 0 && delay < WAKE_SCHEDULER_RETRY_CAP_MINUTES) {
+        delay *= 2;
+    }
+    if (delay > WAKE_SCHEDULER_RETRY_CAP_MINUTES) delay = WAKE_SCHEDULER_RETRY_CAP_MINUTES;
+
+    debug_log("Wake scheduler: failure %d in a row, retry in %d min\n", wake_state.data.failure_streak, delay);
+    return delay;
+}
+
+/**
+ * @brief Per-device delay in minutes for wake-ups at a common wall-clock time.
+ *
+ * `wake_skew_slot` if configured, otherwise derived from the station MAC kept in
+ * the wake state. Before the first Wi-Fi wake the MAC is unknown and the unique
+ * ID of the flash chip is used instead.
+ */
+static int wake_skew_minutes(void) {
+    const device_config_data_t* cfg = &device_config_flash.data;
+    if (cfg->wake_skew_max_minutes <= 0) {
+        return 0;
+    }
+
+    uint32_t seed;
+    if (cfg->wake_skew_slot >= 0) {
+        seed = (uint32_t)cfg->wake_skew_slot;
+    } else {
+        static const uint8_t no_mac[sizeof(wake_state.data.mac)] = {0};
+        if (memcmp(wake_state.data.mac, no_mac, sizeof(no_mac)) != 0) {
+            seed = calc_crc32(wake_state.data.mac, sizeof(wake_state.data.mac));
+        } else {
+            pico_unique_board_id_t id;
+            pico_get_unique_board_id(&id);
+            seed = calc_crc32(id.id, sizeof(id.id));
+        }
+    }
+    return (int)(seed % (uint32_t)(cfg->wake_skew_max_minutes + 1));
+}
+
+/**
+ * @brief Converts local time (with DST) back to the RTC standard time.
+ */
+static uint32_t local_to_rtc_minutes(uint32_t local_minutes) {
+    ds3231_data_t t;
+    rtc_minutes_to_time(local_minutes - RTC_DST_SHIFT_MINUTES, &t);
+    return is_dst_europe(&t) ? local_minutes - RTC_DST_SHIFT_MINUTES : local_minutes;
+}
+
+/**
+ * @brief Computes the next wake-up and returns it as RTC alarm 2 setting.
+ *
+ * - Page 0 with booking data and `wake_ceiling_minutes` > 0: wake at the next booking
+ *   start/end (see minutes_until_booking_change()).
+ * - After a Wi-Fi/server error: retry with exponential backoff (see retry_delay_minutes()).
+ * - Otherwise: fixed interval `refresh_minutes_by_pushbutton[pushbutton]`, or the
+ *   interval of the current schedule window if it has one.
+ * - Intervals and ceilings are stretched in the low-battery tiers (power_governor.c).
+ * - With `query_only_at_officehours` the wake-up is moved to the next opening of the
+ *   weekly schedule (schedule.c), skipping closed days and holidays entirely.
+ * - The RTC holds regional standard time; the schedule is applied in local time
+ *   (with DST) and converted back.
+ * - Wake-ups at a booking change or a schedule opening are delayed by the
+ *   per-device skew (see wake_skew_minutes()), so a fleet does not hit the access
+ *   point and the server in the same minute. Interval wakes keep the phase.
+ *
+ * The alarm matches date, hour and minute, so it may lie up to
+ * WAKE_SCHEDULER_MAX_SLEEP_MINUTES ahead.
+ *
+ * @param now        Current RTC time.
+ * @param pushbutton Page that is displayed.
+ * @param alarm      Output: date/hour/minute for ON_MATCHING_MINUTE_HOUR_AND_DATE.
+ */
+void wake_scheduler_next_alarm(const ds3231_data_t* now, int pushbutton, ds3231_alarm_2_t* alarm) {
+    const device_config_data_t* cfg = &device_config_flash.data;
+    const uint32_t now_minutes = rtc_minutes_since_2000(now);
+    const uint32_t local_now = now_minutes + (is_dst_europe(now) ? RTC_DST_SHIFT_MINUTES : 0);
+    const bool scheduled = schedule_is_active(cfg);
+
+    int interval = cfg->refresh_minutes_by_pushbutton[pushbutton & 0x07]; // use only 3 bits
+    if (scheduled) {
+        const schedule_window_t* window = schedule_window_at(cfg, local_now);
+        if (window != NULL && window->interval_minutes > 0) {
+            interval = window->interval_minutes;
+        }
+    }
+
+    int refresh = power_governor_refresh_minutes(interval);
+    bool common_time = false; // Wake-up at a time other devices share
+    if (retry_pending) {
+        refresh = power_governor_refresh_minutes(retry_delay_minutes());
+    } else if (pushbutton == 0 && booking_schedule.valid && cfg->wake_ceiling_minutes > 0) {
+        refresh = minutes_until_booking_change(now_minutes, &common_time);
+    }
+    if (refresh < 1) refresh = 1;
+    if (refresh > WAKE_SCHEDULER_MAX_SLEEP_MINUTES) refresh = WAKE_SCHEDULER_MAX_SLEEP_MINUTES;
+
+    uint32_t local_wake = local_now + refresh;
+    if (scheduled) {
+        uint32_t open = schedule_next_open(cfg, local_wake, local_now + WAKE_SCHEDULER_MAX_SLEEP_MINUTES);
+        if (open != local_wake) {
+            common_time = true;
+            local_wake = open;
+        }
+    }
+    if (common_time) {
+        int skew = wake_skew_minutes();
+        local_wake += skew;
+        debug_log("Wake scheduler: wake skew %d min\n", skew);
+    }
+    if (local_wake > local_now + WAKE_SCHEDULER_MAX_SLEEP_MINUTES) {
+        local_wake = local_now + WAKE_SCHEDULER_MAX_SLEEP_MINUTES; // Also bounds the skew: the alarm cannot lie further ahead
+    }
+
+    ds3231_data_t wake;
+    rtc_minutes_to_time(local_to_rtc_minutes(local_wake), &wake);
+
+    debug_log("Wake scheduler: next wake-up in %lu min (RTC %02d.%02d. %02d:%02d)\n",
+              (unsigned long)(local_wake - local_now), wake.date, wake.month, wake.hours, wake.minutes);
+
+    memset(alarm, 0, sizeof(*alarm));
+    alarm->minutes = wake.minutes;
+    alarm->hours = wake.hours;
+    alarm->day = wake.day;
+    alarm->date = wake.date;
+    alarm->am_pm = false;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file wake_scheduler.h
+ * @brief Booking-aware computation of the next RTC wake-up.
+ *
+ * Instead of waking every `refresh_minutes_by_pushbutton[0]` minutes, the
+ * default page wakes when its content can actually change: at the next
+ * booking start or end reported by the server. While the seat is booked the
+ * device sleeps until the booking ends (bounded by `wake_ceiling_minutes`),
+ * while it is free the page 0 refresh interval acts as ceiling so new
+ * bookings still show up. With the weekly schedule enabled the wake-up is
+ * moved to the next schedule window; closed days and holidays are skipped.
+ *
+ * After a failed server update the next wake is a retry with exponential
+ * backoff: `wifi_reconnect_minutes`, doubled for every further failure in a
+ * row, capped at WAKE_SCHEDULER_RETRY_CAP_MINUTES. The failure streak is kept
+ * in the EEPROM wake state and reset by the first success.
+ *
+ * Wake-ups that many devices share (a booking change, the schedule opening)
+ * are delayed by a per-device skew of 0..`wake_skew_max_minutes`, taken from
+ * `wake_skew_slot` or derived from the MAC address.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "ds3231.h"
+#include "config.h"
+#include "wifi.h"
+
+#define WAKE_SCHEDULER_MAX_BOOKINGS       16
+#define WAKE_SCHEDULER_MAX_SLEEP_MINUTES  (27 * 24 * 60) ///< Alarm 2 matches date:hour:minute, stay below one month
+#define WAKE_SCHEDULER_WINDOW_MINUTES     (24 * 60)       ///< Booking window requested from the server
+#define RTC_UTC_OFFSET_MINUTES            (TIMEZONE_OFFSET_HOURS * 60) ///< RTC runs regional standard time (config.h)
+#define RTC_DST_SHIFT_MINUTES             60              ///< Summer time is one hour ahead (is_dst_europe())
+#define WAKE_SCHEDULER_RETRY_CAP_MINUTES  240             ///< Longest retry delay after repeated failures
+
+/**
+ * @brief Bookings of the displayed space, times in RTC minutes since 2000 (see rtc_minutes_since_2000()).
+ */
+typedef struct {
+    bool valid;                ///< Booking data was received in this wake cycle
+    int count;
+    uint32_t enter[WAKE_SCHEDULER_MAX_BOOKINGS];
+    uint32_t leave[WAKE_SCHEDULER_MAX_BOOKINGS];
+} booking_schedule_t;
+
+extern booking_schedule_t booking_schedule;
+
+void wake_scheduler_parse_bookings(const char* json, booking_schedule_t* out);
+void wake_scheduler_format_time(uint32_t rtc_minutes, char* buffer, size_t buffer_size);
+void wake_scheduler_record_result(WifiResult result);
+void wake_scheduler_next_alarm(const ds3231_data_t* now, int pushbutton, ds3231_alarm_2_t* alarm);
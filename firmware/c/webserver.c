@@ -346,6 +346,10 @@ void add_timeout_info(char *buf, size_t buf_size) {
 
 static err_t send_next_chunk(void *arg, struct tcp_pcb *tpcb, u16_t len);
 void send_response(struct tcp_pcb* tpcb, const char* body) {
+    send_response_with_type(tpcb, body, "text/html; charset=UTF-8");
+}
+
+void send_response_with_type(struct tcp_pcb* tpcb, const char* body, const char* content_type) {
     int body_len = strlen(body);
     // debug_log("send_response: body_len = %d\n", body_len);
 
@@ -361,10 +365,10 @@ void send_response(struct tcp_pcb* tpcb, const char* body) {
     char header[256];
     int header_len = snprintf(header, sizeof(header),
                               "HTTP/1.0 200 OK\r\n"
-                              "Content-Type: text/html; charset=UTF-8\r\n"
+                              "Content-Type: %s\r\n"
                               "Content-Length: %d\r\n"
                               "Connection: close\r\n\r\n",
-                              body_len);
+                              content_type, body_len);
 
     // debug_log("send_response: sending header (%d bytes)\n", header_len);
     err_t err = tcp_write(tpcb, header, header_len, TCP_WRITE_FLAG_COPY);
@@ -791,6 +795,8 @@ static const route_t routes[] = {
     {"/device_status", HTTP_GET, ROUTE_SIMPLE, {.simple_handler = send_device_status_page}},
     {"/upload_logo", HTTP_GET, ROUTE_SIMPLE, {.simple_handler = send_upload_logo_page_wrapper}},
     {"/firmware_update", HTTP_GET, ROUTE_SIMPLE, {.simple_handler = send_firmware_update_page_wrapper}},
+    {"/wake_log", HTTP_GET, ROUTE_SIMPLE, {.simple_handler = send_wake_log_page}},
+    {"/metrics", HTTP_GET, ROUTE_SIMPLE, {.simple_handler = send_metrics_page}},
     {"/logo", HTTP_GET, ROUTE_INLINE, {.inline_handler = handle_logo_route}},
     {"/shutdown", HTTP_GET, ROUTE_INLINE, {.inline_handler = handle_shutdown_route}},
     
@@ -28,6 +28,26 @@ extern "C" {
         bool show_query_date;
         bool query_only_at_officehours;
         float conversion_factor;
+        int deghost_clear_interval;
+        int partial_refresh_max_percent;
+        int fast_refresh_mode;
+        int full_refresh_every;
+        int full_refresh_changed_percent;
+        bool fast_reconnect;
+        char static_ip[16];
+        char static_netmask[16];
+        char static_gateway[16];
+        int wake_ceiling_minutes;
+        float switch_off_battery_voltage;
+        float power_saving_voltage;
+        float power_critical_voltage;
+        int wake_skew_max_minutes;
+        int wake_skew_slot;
+        char ntp_server[16];
+        int ntp_threshold_seconds;
+        int epaper_spi_khz;
+        char schedule_windows[MAX_FIELD_LENGTH];
+        char holidays[MAX_FIELD_LENGTH];
 
         // Optional bestehende Felder
         char text[128][MAX_FIELD_LENGTH];
@@ -77,6 +97,7 @@ extern "C" {
     // Utility functions for HTML page generation
     void add_timeout_info(char *buf, size_t buf_size);
     void send_response(struct tcp_pcb* tpcb, const char* body);
+    void send_response_with_type(struct tcp_pcb* tpcb, const char* body, const char* content_type);
 
     #ifdef __cplusplus
 }
@@ -30,6 +30,11 @@
 #include "pico/cyw43_arch.h"
 #include "ds3231.h"
 #include "webserver_utils.h"
+#include "eeprom.h"
+#include "wake_metrics.h"
+#include "power_governor.h"
+#include "schedule.h"
+#include "time_sync.h"
 
 // =============================================================================
 // HTML PAGE GENERATION FUNCTIONS
@@ -67,6 +72,7 @@ void send_landing_page(struct tcp_pcb *tpcb) {
            "<a href=\"/device_settings\">Device Settings</a><br>"
            "<a href=\"/upload_logo\">Upload Logo</a><br>"
            "<a href=\"/device_status\">Device Status</a><br>"
+           "<a href=\"/wake_log\">Wake Log</a><br>"
            "<a href=\"/firmware_update\">Firmware Update</a><br>"
            "<a href=\"/clock\">Set Clock</a><br>"
            "<a href=\"/shutdown\">Reboot</a>");
@@ -119,6 +125,8 @@ void send_device_status_page(struct tcp_pcb* tpcb) {
     // Voltage assessment (for simple color coding)
     const char* vcc_color = (vcc > 3.5) ? "green" : (vcc > 3.0 ? "orange" : "red");
     const char* vbat_color = (vbat > 3.1) ? "green" : (vbat > 2.9 ? "orange" : "red");
+    const char* tier_color = (power_governor_tier() == POWER_TIER_NORMAL) ? "green" :
+                             (power_governor_tier() == POWER_TIER_SAVING ? "orange" : "red");
 
     snprintf(page, sizeof(page),
              "<!DOCTYPE html><html><head>"
@@ -193,9 +201,11 @@ void send_device_status_page(struct tcp_pcb* tpcb) {
              "<div class='section'>"
              "Vcc: <span class='value %s'>%.3f V</span><br>"
              "Vbat: <span class='value %s'>%.3f V</span><br>"
+             "Power tier: <span class='value %s'>%s</span><br>"
              "ADC Conversion Factor: <span class='value'>%.8f</span></div>",
              vcc_color, vcc,
              vbat_color, vbat,
+             tier_color, power_tier_name(power_governor_tier()),
              device_config_flash.data.conversion_factor);
     strcat(page, buffer);
 
@@ -273,6 +283,122 @@ void send_device_status_page(struct tcp_pcb* tpcb) {
     send_response(tpcb, page);
 }
 
+/**
+ * @brief Generates and sends the wake log page (last wake cycles from the EEPROM ring)
+ * @param tpcb TCP connection pointer
+ *
+ * One row per wake: time, page, Wi-Fi result, refresh, battery voltage and
+ * the duration of every phase in ms (see wake_phase_t).
+ */
+void send_wake_log_page(struct tcp_pcb* tpcb) {
+    static const char* const refresh_names[] = {"full", "fast", "partial", "?"};
+    static char page[8192]; // Not on the stack: lwIP callback context, send_response() copies it
+    wake_record_t r;
+
+    extern ds3231_t ds3231;
+
+    snprintf(page, sizeof(page),
+             "<!DOCTYPE html><html><head>"
+             "<meta charset=\"UTF-8\">"
+             "<meta name=\"viewport\" content=\"width=device-width, initial-scale=1\">"
+             "<title>Wake Log</title>"
+             "<style>"
+             "body { font-family: sans-serif; text-align: center; padding: 1em; }"
+             "table { margin: auto; border-collapse: collapse; font-size: 0.8em; }"
+             "td, th { border: 1px solid #ccc; padding: 2px 4px; text-align: right; }"
+             "a { display: inline-block; margin-top: 2em; text-decoration: none; color: #0066cc; }"
+             "</style></head><body>"
+             "<h1>Wake Log</h1>"
+             "<table><tr><th>#</th><th>Time</th><th>Page</th><th>Wi-Fi</th><th>Refresh</th><th>mV</th>");
+
+    for (int p = 0; p < WAKE_PHASE_COUNT; p++) {
+        snprintf(page + strlen(page), sizeof(page) - strlen(page),
+                 "<th>%s</th>", wake_metrics_phase_name((wake_phase_t)p));
+    }
+    snprintf(page + strlen(page), sizeof(page) - strlen(page), "</tr>");
+
+    uint16_t seq = wake_state.data.metrics_seq;
+    for (int i = 0; i < 16 && wake_metrics_read(&ds3231, seq, &r); i++, seq--) {
+        uint32_t minute_of_day = r.rtc_minutes % (24 * 60);
+        snprintf(page + strlen(page), sizeof(page) - strlen(page),
+                 "<tr><td>%u</td><td>%lu %02lu:%02lu</td><td>%u</td><td>%u</td><td>%s</td><td>%u</td>",
+                 r.seq, (unsigned long)(r.rtc_minutes / (24 * 60)),
+                 (unsigned long)(minute_of_day / 60), (unsigned long)(minute_of_day % 60),
+                 r.flags & 0x07, (r.flags >> 3) & 0x03,
+                 (r.flags & 0x80) ? refresh_names[(r.flags >> 5) & 0x03] : "-",
+                 r.battery_mv);
+
+        for (int p = 0; p < WAKE_PHASE_COUNT; p++) {
+            snprintf(page + strlen(page), sizeof(page) - strlen(page), "<td>%u</td>", r.phase_ms[p]);
+        }
+        snprintf(page + strlen(page), sizeof(page) - strlen(page), "</tr>");
+    }
+
+    snprintf(page + strlen(page), sizeof(page) - strlen(page),
+             "</table><p><small>Time: days since 2000 and RTC time. Wi-Fi: 0 = ok, 1 = connection error, "
+             "2 = server error, 3 = not required. Phases in ms.</small></p>"
+             "<a href=\"/metrics\">Prometheus metrics</a><br>"
+             "<a href=\"/\">back</a></body></html>");
+
+    send_response(tpcb, page);
+}
+
+/**
+ * @brief Sends the wake log as Prometheus text exposition (/metrics)
+ * @param tpcb TCP connection pointer
+ *
+ * Per phase: duration of the last wake and average/maximum over all records
+ * in the ring, plus the battery voltage of the last wake.
+ */
+void send_metrics_page(struct tcp_pcb* tpcb) {
+    static char page[4096]; // Not on the stack: lwIP callback context, send_response() copies it
+    uint32_t sum[WAKE_PHASE_COUNT] = {0};
+    uint16_t max[WAKE_PHASE_COUNT] = {0};
+    wake_record_t last, r;
+    int count = 0;
+
+    extern ds3231_t ds3231;
+
+    uint16_t seq = wake_state.data.metrics_seq;
+    for (; count < WAKE_LOG_RECORDS && wake_metrics_read(&ds3231, seq, &r); count++, seq--) {
+        if (count == 0) {
+            last = r;
+        }
+        for (int p = 0; p < WAKE_PHASE_COUNT; p++) {
+            sum[p] += r.phase_ms[p];
+            if (r.phase_ms[p] > max[p]) max[p] = r.phase_ms[p];
+        }
+    }
+
+    snprintf(page, sizeof(page),
+             "# HELP inki_wake_records Wake records in the EEPROM ring.\n"
+             "# TYPE inki_wake_records gauge\n"
+             "inki_wake_records %d\n", count);
+
+    if (count > 0) {
+        static const char* const series[] = {"last", "avg", "max"};
+        for (int s = 0; s < 3; s++) {
+            snprintf(page + strlen(page), sizeof(page) - strlen(page),
+                     "# HELP inki_wake_phase_ms_%s Wake phase duration in ms (%s).\n"
+                     "# TYPE inki_wake_phase_ms_%s gauge\n",
+                     series[s], series[s], series[s]);
+
+            for (int p = 0; p < WAKE_PHASE_COUNT; p++) {
+                unsigned value = (s == 0) ? last.phase_ms[p] : (s == 1) ? sum[p] / count : max[p];
+                snprintf(page + strlen(page), sizeof(page) - strlen(page), "inki_wake_phase_ms_%s{phase=\"%s\"} %u\n",
+                         series[s], wake_metrics_phase_name((wake_phase_t)p), value);
+            }
+        }
+
+        snprintf(page + strlen(page), sizeof(page) - strlen(page),
+                 "# HELP inki_wake_battery_mv_last Battery voltage of the last wake in mV.\n"
+                 "# TYPE inki_wake_battery_mv_last gauge\n"
+                 "inki_wake_battery_mv_last %u\n", last.battery_mv);
+    }
+
+    send_response_with_type(tpcb, page, "text/plain; version=0.0.4");
+}
+
 /**
  * @brief Generates and sends the logo upload page
  * @param tpcb TCP connection pointer
@@ -638,7 +764,7 @@ void send_seatsurfing_config_page(struct tcp_pcb* tpcb, const char* message) {
  * Includes current time display and manual time entry fields.
  */
 void send_clock_page(struct tcp_pcb *tpcb, const char *message) {
-    char page[8192];
+    static char page[8192]; // Not on the stack: lwIP callback context, send_response() copies it
     char timeout_info[64];
     add_timeout_info(timeout_info, sizeof(timeout_info));
 
@@ -656,6 +782,10 @@ void send_clock_page(struct tcp_pcb *tpcb, const char *message) {
     char current_dst[64];
     format_rtc_time(&current, current_dst, sizeof(current_dst));
 
+    // SNTP comparisons and aging offset
+    static char drift_log[2560];
+    time_sync_format_history(&ds3231, drift_log, sizeof(drift_log));
+
     snprintf(page, sizeof(page),
              "<!DOCTYPE html><html><head>"
              "<meta charset=\"UTF-8\">"
@@ -683,6 +813,8 @@ void send_clock_page(struct tcp_pcb *tpcb, const char *message) {
              "<input type=\"submit\" value=\"Uhr stellen\">"
              "</form>"
 
+             "<h2>SNTP</h2>%s"
+
              "<p><a href=\"/\">Back</a></p>"
              "<p>%s</p>"
 
@@ -705,6 +837,7 @@ void send_clock_page(struct tcp_pcb *tpcb, const char *message) {
              (message && *message) ? "<div class='message'>" : "",
              (message && *message) ? message : "",
              (message && *message) ? "</div>" : "",
+             drift_log,
              timeout_info);
 
     debug_log("device settings page length: %d\n", strlen(page));
@@ -722,7 +855,7 @@ void send_clock_page(struct tcp_pcb *tpcb, const char *message) {
  * - Power management and watchdog settings
  */
 void send_device_config_page(struct tcp_pcb* tpcb, const char* message) {
-    char page[8192];
+    static char page[10240]; // Not on the stack: lwIP callback context, send_response() copies it
     char timeout_info[64];
     add_timeout_info(timeout_info, sizeof(timeout_info));
 
@@ -823,9 +956,21 @@ void send_device_config_page(struct tcp_pcb* tpcb, const char* message) {
              device_config_flash.data.refresh_minutes_by_pushbutton[6]);
 
     snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
-             "<label>Page 7: <input type=\"number\" name=\"refresh7\" value=\"%d\" min=\"1\" max=\"1440\"></label>",
+             "<label>Page 7: <input type=\"number\" name=\"refresh7\" value=\"%d\" min=\"1\" max=\"1440\"></label><br>",
              device_config_flash.data.refresh_minutes_by_pushbutton[7]);
 
+    // Booking-aware wake-up of page 0
+    snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
+             "<label>Page 0 max. sleep while booked (0 = fixed interval): <input type=\"number\" name=\"wake_ceiling_minutes\" value=\"%d\" min=\"0\" max=\"1439\"></label>",
+             device_config_flash.data.wake_ceiling_minutes);
+
+    // Per-device phase of wake-ups that many devices share (schedule opening, booking change)
+    snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
+             "<br><label>Max. wake skew (min, 0 = off): <input type=\"number\" name=\"wake_skew_max_minutes\" value=\"%d\" min=\"0\" max=\"59\"></label><br>"
+             "<label>Wake slot (min, -1 = from MAC): <input type=\"number\" name=\"wake_skew_slot\" value=\"%d\" min=\"-1\" max=\"59\"></label>",
+             device_config_flash.data.wake_skew_max_minutes,
+             device_config_flash.data.wake_skew_slot);
+
     snprintf(strchr(page, '\0'), sizeof(page) - strlen(page), "</fieldset>");
 
     // WiFi Settings section
@@ -842,14 +987,40 @@ void send_device_config_page(struct tcp_pcb* tpcb, const char* message) {
              "<label>Max Wait for Data (ms):<br>"
              "<input type=\"number\" name=\"max_wait_data_wifi\" value=\"%d\" min=\"10\" max=\"10000\"></label>"
 
-             "<label>WiFi Reconnect Minutes:<br>"
+             "<label>First Retry after Error (min, doubles up to 4 h):<br>"
              "<input type=\"number\" name=\"wifi_reconnect_minutes\" value=\"%d\" min=\"1\" max=\"30\"></label>"
 
+             "<label class=\"inline\"><input type=\"checkbox\" name=\"fast_reconnect\" value=\"1\" %s> Fast reconnect (cached AP and lease)</label>"
+
+             // Static IP (0.0.0.0 = DHCP)
+             "<label>Static IP (0.0.0.0 = DHCP):<br>"
+             "<input type=\"text\" name=\"static_ip\" value=\"%d.%d.%d.%d\"></label>"
+             "<label>Netmask:<br>"
+             "<input type=\"text\" name=\"static_netmask\" value=\"%d.%d.%d.%d\"></label>"
+             "<label>Gateway:<br>"
+             "<input type=\"text\" name=\"static_gateway\" value=\"%d.%d.%d.%d\"></label>"
+
+             // RTC check against a time server (single SNTP packet)
+             "<label>SNTP Server (0.0.0.0 = off):<br>"
+             "<input type=\"text\" name=\"ntp_server\" value=\"%d.%d.%d.%d\"></label>"
+             "<label>Set Clock if off by (s, 0 = log only):<br>"
+             "<input type=\"number\" name=\"ntp_threshold_seconds\" value=\"%d\" min=\"0\" max=\"3600\"></label>"
+
              "</fieldset>",
              device_config_flash.data.number_wifi_attempts,
              device_config_flash.data.wifi_timeout,
              device_config_flash.data.max_wait_data_wifi,
-             device_config_flash.data.wifi_reconnect_minutes);
+             device_config_flash.data.wifi_reconnect_minutes,
+             (device_config_flash.data.fast_reconnect ? "checked" : ""),
+             device_config_flash.data.static_ip[0], device_config_flash.data.static_ip[1],
+             device_config_flash.data.static_ip[2], device_config_flash.data.static_ip[3],
+             device_config_flash.data.static_netmask[0], device_config_flash.data.static_netmask[1],
+             device_config_flash.data.static_netmask[2], device_config_flash.data.static_netmask[3],
+             device_config_flash.data.static_gateway[0], device_config_flash.data.static_gateway[1],
+             device_config_flash.data.static_gateway[2], device_config_flash.data.static_gateway[3],
+             device_config_flash.data.ntp_server[0], device_config_flash.data.ntp_server[1],
+             device_config_flash.data.ntp_server[2], device_config_flash.data.ntp_server[3],
+             device_config_flash.data.ntp_threshold_seconds);
 
     // Hardware settings section
     snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
@@ -857,7 +1028,13 @@ void send_device_config_page(struct tcp_pcb* tpcb, const char* message) {
 
              // Battery cutoff voltage
              "<label>Battery Cutoff Voltage (V):<br>"
-             "<input type=\"number\" step=\"0.1\" name=\"switch_off_battery_voltage\" value=\"%.2f\" min=\"2.4\" max=\"3.9\"></label><br>"
+             "<input type=\"number\" step=\"0.01\" name=\"switch_off_battery_voltage\" value=\"%.2f\" min=\"2.4\" max=\"3.9\"></label><br>"
+
+             // Power tiers
+             "<label>Power Saving below (V, 0 = off):<br>"
+             "<input type=\"number\" step=\"0.01\" name=\"power_saving_voltage\" value=\"%.2f\" min=\"0\" max=\"4.9\"></label><br>"
+             "<label>Critical below (V, 0 = off):<br>"
+             "<input type=\"number\" step=\"0.01\" name=\"power_critical_voltage\" value=\"%.2f\" min=\"0\" max=\"4.9\"></label><br>"
 
              // Watchdog timeout
              "<label>Watchdog Timeout (ms):<br>"
@@ -869,14 +1046,68 @@ void send_device_config_page(struct tcp_pcb* tpcb, const char* message) {
 
              "</fieldset>",
              device_config_flash.data.switch_off_battery_voltage,
+             device_config_flash.data.power_saving_voltage,
+             device_config_flash.data.power_critical_voltage,
              device_config_flash.data.watchdog_time,
              device_config_flash.data.conversion_factor);
 
+    // Display refresh policy
+    snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
+             "<fieldset><legend>Display Refresh</legend>"
+
+             // Deghosting clear
+             "<label>Clear panel every Nth refresh (0 = never):<br>"
+             "<input type=\"number\" name=\"deghost_clear_interval\" value=\"%d\" min=\"0\" max=\"1000\"></label>"
+
+             // Partial refresh (4.2 inch)
+             "<label>Partial refresh up to %% of panel changed (0 = off):<br>"
+             "<input type=\"number\" name=\"partial_refresh_max_percent\" value=\"%d\" min=\"0\" max=\"100\"></label>"
+
+             // Fast waveform (4.2 inch)
+             "<strong>Fast refresh (4.2 Zoll)</strong><br>"
+             "<label class=\"inline\"><input type=\"radio\" name=\"fast_refresh_mode\" value=\"0\" %s> Off</label>"
+             "<label class=\"inline\"><input type=\"radio\" name=\"fast_refresh_mode\" value=\"1\" %s> 1.5 s</label>"
+             "<label class=\"inline\"><input type=\"radio\" name=\"fast_refresh_mode\" value=\"2\" %s> 1 s</label>"
+
+             "<label style=\"margin-top:1em; display:block;\">Full refresh after N fast/partial refreshes (0 = never):<br>"
+             "<input type=\"number\" name=\"full_refresh_every\" value=\"%d\" min=\"0\" max=\"1000\"></label>"
+
+             "<label>Full refresh if more than %% of pixels changed (0 = off):<br>"
+             "<input type=\"number\" name=\"full_refresh_changed_percent\" value=\"%d\" min=\"0\" max=\"100\"></label>"
+
+             "<label>Panel SPI clock (kHz, 0 = panel maximum):<br>"
+             "<input type=\"number\" name=\"epaper_spi_khz\" value=\"%d\" min=\"0\" max=\"30000\"></label>"
+
+             "</fieldset>",
+             device_config_flash.data.deghost_clear_interval,
+             device_config_flash.data.partial_refresh_max_percent,
+             (device_config_flash.data.fast_refresh_mode == 0 ? "checked" : ""),
+             (device_config_flash.data.fast_refresh_mode == 1 ? "checked" : ""),
+             (device_config_flash.data.fast_refresh_mode == 2 ? "checked" : ""),
+             device_config_flash.data.full_refresh_every,
+             device_config_flash.data.full_refresh_changed_percent,
+             device_config_flash.data.epaper_spi_khz);
+
+    // Weekly schedule
+    char schedule_text[MAX_FIELD_LENGTH];
+    char holiday_text[MAX_FIELD_LENGTH];
+    schedule_format_windows(device_config_flash.data.schedule_windows, SCHEDULE_MAX_WINDOWS, schedule_text, sizeof(schedule_text));
+    schedule_format_holidays(device_config_flash.data.holidays, SCHEDULE_MAX_HOLIDAYS, holiday_text, sizeof(holiday_text));
+
+    snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
+             "<fieldset><legend>Weekly Schedule</legend>"
+             "<label>Wake windows (e.g. Mo-Fr 06:00-19:00 30; Sa 08:00-12:00):<br>"
+             "<input type=\"text\" name=\"schedule_windows\" value=\"%s\" maxlength=\"127\"></label>"
+             "<label>Closure days (MM-DD or YYYY-MM-DD):<br>"
+             "<input type=\"text\" name=\"holidays\" value=\"%s\" maxlength=\"127\"></label>"
+             "</fieldset>",
+             schedule_text, holiday_text);
+
     // Checkboxes
     snprintf(strchr(page, '\0'), sizeof(page) - strlen(page),
              "<div style=\"margin-top: 1em;\">"
              "<label class=\"inline\"><input type=\"checkbox\" name=\"show_query_date\" value=\"1\" %s> Show query timestamp</label><br>"
-             "<label class=\"inline\"><input type=\"checkbox\" name=\"query_only_at_officehours\" value=\"1\" %s> Query only during office hours</label><br>"
+             "<label class=\"inline\"><input type=\"checkbox\" name=\"query_only_at_officehours\" value=\"1\" %s> Wake only within the weekly schedule</label><br>"
              "</div>",
              (device_config_flash.data.show_query_date ? "checked" : ""),
              (device_config_flash.data.query_only_at_officehours ? "checked" : ""));
@@ -998,6 +1229,24 @@ void handle_form_seatsurfing(struct tcp_pcb *tpcb, const char *body, size_t len)
     send_seatsurfing_config_page(tpcb, "✔ seatsurfing settings stored");
 }
 
+/**
+ * @brief Parses a dotted IPv4 address from a form field
+ * @param text Field value ("a.b.c.d")
+ * @param out Parsed address; unchanged if the field is invalid
+ */
+static void parse_ipv4_field(const char* text, uint8_t out[4]) {
+    int a, b, c, d;
+    if (sscanf(text, "%d.%d.%d.%d", &a, &b, &c, &d) == 4 &&
+        a >= 0 && a <= 255 && b >= 0 && b <= 255 && c >= 0 && c <= 255 && d >= 0 && d <= 255) {
+        out[0] = (uint8_t)a;
+        out[1] = (uint8_t)b;
+        out[2] = (uint8_t)c;
+        out[3] = (uint8_t)d;
+    } else {
+        debug_log_with_color(COLOR_RED, "Invalid IP address: %s\n", text);
+    }
+}
+
 /**
  * @brief Processes device configuration form submissions
  * @param tpcb TCP connection pointer
@@ -1037,6 +1286,38 @@ void handle_form_device_config(struct tcp_pcb *tpcb, const char *body, size_t le
     new_cfg.data.wifi_timeout = result.wifi_timeout;
     new_cfg.data.max_wait_data_wifi = result.max_wait_data_wifi;
     new_cfg.data.conversion_factor = result.conversion_factor;
+    new_cfg.data.deghost_clear_interval = result.deghost_clear_interval;
+    new_cfg.data.partial_refresh_max_percent = result.partial_refresh_max_percent;
+    new_cfg.data.fast_refresh_mode = result.fast_refresh_mode;
+    new_cfg.data.full_refresh_every = result.full_refresh_every;
+    new_cfg.data.full_refresh_changed_percent = result.full_refresh_changed_percent;
+    new_cfg.data.fast_reconnect = result.fast_reconnect;
+    parse_ipv4_field(result.static_ip, new_cfg.data.static_ip);
+    parse_ipv4_field(result.static_netmask, new_cfg.data.static_netmask);
+    parse_ipv4_field(result.static_gateway, new_cfg.data.static_gateway);
+    new_cfg.data.wake_ceiling_minutes = result.wake_ceiling_minutes;
+    new_cfg.data.switch_off_battery_voltage = result.switch_off_battery_voltage;
+    new_cfg.data.power_saving_voltage = result.power_saving_voltage;
+    new_cfg.data.power_critical_voltage = result.power_critical_voltage;
+    new_cfg.data.wake_skew_max_minutes = result.wake_skew_max_minutes;
+    new_cfg.data.wake_skew_slot = result.wake_skew_slot;
+    parse_ipv4_field(result.ntp_server, new_cfg.data.ntp_server);
+    new_cfg.data.ntp_threshold_seconds = result.ntp_threshold_seconds;
+    new_cfg.data.epaper_spi_khz = result.epaper_spi_khz;
+
+    // Weekly schedule: keep the stored one if the text does not parse
+    schedule_window_t windows[SCHEDULE_MAX_WINDOWS];
+    schedule_holiday_t holidays[SCHEDULE_MAX_HOLIDAYS];
+    if (schedule_parse_windows(result.schedule_windows, windows, SCHEDULE_MAX_WINDOWS) >= 0) {
+        memcpy(new_cfg.data.schedule_windows, windows, sizeof(windows));
+    } else {
+        debug_log_with_color(COLOR_RED, "Invalid schedule: %s\n", result.schedule_windows);
+    }
+    if (schedule_parse_holidays(result.holidays, holidays, SCHEDULE_MAX_HOLIDAYS) >= 0) {
+        memcpy(new_cfg.data.holidays, holidays, sizeof(holidays));
+    } else {
+        debug_log_with_color(COLOR_RED, "Invalid closure days: %s\n", result.holidays);
+    }
 
     bool ok = save_device_config(&new_cfg);
 
@@ -1080,6 +1361,7 @@ void handle_form_clock(struct tcp_pcb *tpcb, const char *body, size_t len) {
 
     ds3231_read_current_time(&ds3231, &old_time);
     set_rtc_from_display_string(&ds3231, decoded_line);
+    time_sync_clock_set_manually(&ds3231);
     ds3231_read_current_time(&ds3231, &new_time);
 
     int old_min = old_time.hours * 60 + old_time.minutes;
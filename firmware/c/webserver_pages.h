@@ -26,6 +26,8 @@ void send_wifi_config_page(struct tcp_pcb *tpcb, const char *message);
 void send_seatsurfing_config_page(struct tcp_pcb* tpcb, const char* message);
 void send_clock_page(struct tcp_pcb *tpcb, const char *message);
 void send_device_config_page(struct tcp_pcb* tpcb, const char* message);
+void send_wake_log_page(struct tcp_pcb* tpcb);
+void send_metrics_page(struct tcp_pcb* tpcb);
 
 // Form handler functions
 void handle_form_wifi(struct tcp_pcb *tpcb, const char *body, size_t len);
@@ -248,6 +248,66 @@ void parse_form_fields(const char *body, int len, web_submission_t *result) {
         else if (key_len == 17 && strncmp(key, "conversion_factor", 17) == 0) {
             result->conversion_factor = atof(value_buf);
         }
+        else if (key_len == 22 && strncmp(key, "deghost_clear_interval", 22) == 0) {
+            result->deghost_clear_interval = atoi(value_buf);
+        }
+        else if (key_len == 27 && strncmp(key, "partial_refresh_max_percent", 27) == 0) {
+            result->partial_refresh_max_percent = atoi(value_buf);
+        }
+        else if (key_len == 17 && strncmp(key, "fast_refresh_mode", 17) == 0) {
+            result->fast_refresh_mode = atoi(value_buf);
+        }
+        else if (key_len == 18 && strncmp(key, "full_refresh_every", 18) == 0) {
+            result->full_refresh_every = atoi(value_buf);
+        }
+        else if (key_len == 28 && strncmp(key, "full_refresh_changed_percent", 28) == 0) {
+            result->full_refresh_changed_percent = atoi(value_buf);
+        }
+        else if (key_len == 14 && strncmp(key, "fast_reconnect", 14) == 0) {
+            result->fast_reconnect = true;
+        }
+        else if (key_len == 9 && strncmp(key, "static_ip", 9) == 0) {
+            strncpy(result->static_ip, value_buf, sizeof(result->static_ip) - 1);
+        }
+        else if (key_len == 14 && strncmp(key, "static_netmask", 14) == 0) {
+            strncpy(result->static_netmask, value_buf, sizeof(result->static_netmask) - 1);
+        }
+        else if (key_len == 14 && strncmp(key, "static_gateway", 14) == 0) {
+            strncpy(result->static_gateway, value_buf, sizeof(result->static_gateway) - 1);
+        }
+        else if (key_len == 20 && strncmp(key, "wake_ceiling_minutes", 20) == 0) {
+            result->wake_ceiling_minutes = atoi(value_buf);
+        }
+        else if (key_len == 26 && strncmp(key, "switch_off_battery_voltage", 26) == 0) {
+            result->switch_off_battery_voltage = atof(value_buf);
+        }
+        else if (key_len == 20 && strncmp(key, "power_saving_voltage", 20) == 0) {
+            result->power_saving_voltage = atof(value_buf);
+        }
+        else if (key_len == 22 && strncmp(key, "power_critical_voltage", 22) == 0) {
+            result->power_critical_voltage = atof(value_buf);
+        }
+        else if (key_len == 21 && strncmp(key, "wake_skew_max_minutes", 21) == 0) {
+            result->wake_skew_max_minutes = atoi(value_buf);
+        }
+        else if (key_len == 14 && strncmp(key, "wake_skew_slot", 14) == 0) {
+            result->wake_skew_slot = atoi(value_buf);
+        }
+        else if (key_len == 10 && strncmp(key, "ntp_server", 10) == 0) {
+            strncpy(result->ntp_server, value_buf, sizeof(result->ntp_server) - 1);
+        }
+        else if (key_len == 21 && strncmp(key, "ntp_threshold_seconds", 21) == 0) {
+            result->ntp_threshold_seconds = atoi(value_buf);
+        }
+        else if (key_len == 14 && strncmp(key, "epaper_spi_khz", 14) == 0) {
+            result->epaper_spi_khz = atoi(value_buf);
+        }
+        else if (key_len == 16 && strncmp(key, "schedule_windows", 16) == 0) {
+            strncpy(result->schedule_windows, value_buf, sizeof(result->schedule_windows) - 1);
+        }
+        else if (key_len == 8 && strncmp(key, "holidays", 8) == 0) {
+            strncpy(result->holidays, value_buf, sizeof(result->holidays) - 1);
+        }
         ptr = amp + 1;
     }
 }
\ No newline at end of file